@@ -0,0 +1,453 @@
+#include <fit/always.h>
+#include <fit/by.h>
+#include <fit/capture.h>
+#include <fit/compose.h>
+#include <fit/compress.h>
+#include <fit/compress_tree.h>
+#include <fit/conditional.h>
+#include <fit/dispatch.h>
+#include <fit/fix.h>
+#include <fit/fix_trampoline.h>
+#include <fit/flow.h>
+#include <fit/iterate.h>
+#include <fit/lazy.h>
+#include <fit/partial.h>
+#include <fit/pipable.h>
+#include <fit/placeholders.h>
+#include <fit/repeat.h>
+#include <fit/repeat_while.h>
+#include <fit/table.h>
+#include <fit/unpack.h>
+#include <vector>
+#include "bench.h"
+
+struct increment
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x + 1;
+    }
+};
+
+struct twice
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x * 2;
+    }
+};
+
+struct sum
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+struct sum3
+{
+    template<class T, class U, class V>
+    constexpr T operator()(T x, U y, V z) const
+    {
+        return x + y + z;
+    }
+};
+
+struct for_pointers
+{
+    template<class T>
+    int operator()(T* x) const
+    {
+        return *x;
+    }
+};
+
+struct for_ints
+{
+    int operator()(int x) const
+    {
+        return x + 1;
+    }
+};
+
+struct sum_to
+{
+    template<class Self>
+    int operator()(Self self, int n) const
+    {
+        return n == 0 ? 0 : n + self(n - 1);
+    }
+};
+
+struct add_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+// Floating point additions can't be reordered by the compiler, so the left
+// fold is a chain of dependent additions, whereas the tree is not
+template<class F>
+int sum_16(F f, int x)
+{
+    double d = x;
+    return int(f(d, d+1, d+2, d+3, d+4, d+5, d+6, d+7, d+8, d+9, d+10, d+11, d+12, d+13, d+14, d+15)) & 0xffff;
+}
+
+// Takes its buffers by value, so any copy made while unpacking shows up as an
+// allocation in the timings
+struct sum_fronts
+{
+    template<class... Ts>
+    int operator()(std::vector<int> x, Ts... xs) const
+    {
+        return x.front() + sum_fronts()(fit::move(xs)...);
+    }
+
+    int operator()() const
+    {
+        return 0;
+    }
+};
+
+std::vector<int> make_buffer(int x)
+{
+    return std::vector<int>(256, x);
+}
+
+// One step of a linear congruential generator, which can't be folded into a
+// closed form for a runtime count
+struct lcg_step
+{
+    unsigned operator()(unsigned x) const
+    {
+        return x * 1103515245u + 12345u;
+    }
+};
+
+unsigned lcg_loop(unsigned x, int n)
+{
+    for(;n > 0;--n) x = lcg_step()(x);
+    return x;
+}
+
+struct low_bits_set
+{
+    bool operator()(unsigned x) const
+    {
+        return (x & 7) != 0;
+    }
+};
+
+unsigned lcg_while_loop(unsigned x)
+{
+    for(int n = 0;n < 64 && (x & 7) != 0;n++) x = lcg_step()(x);
+    return x;
+}
+
+struct lcg_tail
+{
+    template<class Self>
+    typename Self::step operator()(Self self, int n, unsigned x) const
+    {
+        if (n == 0) return x;
+        return self(n - 1, lcg_step()(x));
+    }
+};
+
+struct sum_to_then
+{
+    template<class Self>
+    typename Self::step operator()(Self self, int n) const
+    {
+        if (n == 0) return 0;
+        return self(n - 1).then([n](int r) -> typename Self::step { return n + r; });
+    }
+};
+
+struct crc_bits
+{
+    template<class Self>
+    FIT_FIX_CONSTEXPR unsigned operator()(Self self, unsigned c, int k) const
+    {
+        return k == 0 ? c : self((c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1), k - 1);
+    }
+};
+
+struct crc_entry
+{
+    FIT_FIX_CONSTEXPR unsigned operator()(std::size_t x) const
+    {
+        return fit::fix(crc_bits())(unsigned(x), 8);
+    }
+};
+
+unsigned crc_byte_loop(unsigned c)
+{
+    for(int k = 0;k < 8;k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+    return c;
+}
+
+int sum_to_loop(int n)
+{
+    return n == 0 ? 0 : n + sum_to_loop(n - 1);
+}
+
+FIT_BENCHMARK_CASE("compose")
+{
+    return fit::bench::compare(
+        [](int x) { return (x * 2) + 1; },
+        fit::compose(increment(), twice())
+    );
+}
+
+FIT_BENCHMARK_CASE("flow")
+{
+    return fit::bench::compare(
+        [](int x) { return (x * 2) + 1; },
+        fit::flow(twice(), increment())
+    );
+}
+
+FIT_BENCHMARK_CASE("by")
+{
+    auto f = fit::by(twice(), sum());
+    return fit::bench::compare(
+        [](int x) { return (x * 2) + (3 * 2); },
+        [f](int x) { return f(x, 3); }
+    );
+}
+
+FIT_BENCHMARK_CASE("partial")
+{
+    auto f = fit::partial(sum3())(1);
+    return fit::bench::compare(
+        [](int x) { return 1 + x + 2; },
+        [f](int x) { return f(x, 2); }
+    );
+}
+
+FIT_BENCHMARK_CASE("capture")
+{
+    return fit::bench::compare(
+        [](int x) { return 1 + x; },
+        fit::capture(1)(sum())
+    );
+}
+
+FIT_BENCHMARK_CASE("lazy")
+{
+    return fit::bench::compare(
+        [](int x) { return x + 1; },
+        fit::lazy(sum())(std::placeholders::_1, 1)
+    );
+}
+
+FIT_BENCHMARK_CASE("placeholders")
+{
+    using fit::_1;
+    return fit::bench::compare(
+        [](int x) { return x * 2 + 1; },
+        fit::lazy(sum())(_1 * 2, 1)
+    );
+}
+
+FIT_BENCHMARK_CASE("pipable")
+{
+    auto f = fit::pipable(sum());
+    return fit::bench::compare(
+        [](int x) { return x + 1; },
+        [f](int x) { return x | f(1); }
+    );
+}
+
+FIT_BENCHMARK_CASE("conditional")
+{
+    return fit::bench::compare(
+        [](int x) { return x + 1; },
+        fit::conditional(for_pointers(), for_ints())
+    );
+}
+
+FIT_BENCHMARK_CASE("fix")
+{
+    return fit::bench::compare(
+        [](int x) { return sum_to_loop(x & 15); },
+        [](int x) { return fit::fix(sum_to())(x & 15); }
+    );
+}
+
+// Here the baseline is a loop, as the recursion is deep
+FIT_BENCHMARK_CASE("fix_trampoline")
+{
+    return fit::bench::compare(
+        [](int x) { return int(lcg_loop(x, (x & 1023) + 1024) & 0xffff); },
+        [](int x) { return int(fit::fix_trampoline<unsigned(int, unsigned)>(lcg_tail())((x & 1023) + 1024, x) & 0xffff); },
+        1000
+    );
+}
+
+FIT_BENCHMARK_CASE("fix_trampoline.then")
+{
+    return fit::bench::compare(
+        [](int x) { int r = 0; for(int n = (x & 15) + 16;n > 0;n--) r += n; return r; },
+        [](int x) { return fit::fix_trampoline<int(int)>(sum_to_then())((x & 15) + 16); },
+        100
+    );
+}
+
+// Here the baseline computes the entries of the table at runtime
+FIT_BENCHMARK_CASE("table<256>")
+{
+    // This is constant initialized when fix is constexpr
+    static const std::array<unsigned, 256> crc_table = fit::table<256>(crc_entry());
+    return fit::bench::compare(
+        [](int x) { return int(crc_byte_loop(x & 0xff) & 0xffff); },
+        [](int x) { return int(crc_table[x & 0xff] & 0xffff); }
+    );
+}
+
+FIT_BENCHMARK_CASE("unpack tuple&&")
+{
+    return fit::bench::compare(
+        [](int x) { 
+            auto t = std::make_tuple(make_buffer(x), make_buffer(1));
+            return sum_fronts()(std::get<0>(std::move(t)), std::get<1>(std::move(t))); 
+        },
+        [](int x) { return fit::unpack(sum_fronts())(std::make_tuple(make_buffer(x), make_buffer(1))); }
+    );
+}
+
+FIT_BENCHMARK_CASE("unpack pair&&")
+{
+    return fit::bench::compare(
+        [](int x) { 
+            auto p = std::make_pair(make_buffer(x), make_buffer(1));
+            return sum_fronts()(std::move(p.first), std::move(p.second)); 
+        },
+        [](int x) { return fit::unpack(sum_fronts())(std::make_pair(make_buffer(x), make_buffer(1))); }
+    );
+}
+
+FIT_BENCHMARK_CASE("unpack array&&")
+{
+    return fit::bench::compare(
+        [](int x) { 
+            std::array<std::vector<int>, 2> a = {{ make_buffer(x), make_buffer(1) }};
+            return sum_fronts()(std::move(a[0]), std::move(a[1])); 
+        },
+        [](int x) { 
+            std::array<std::vector<int>, 2> a = {{ make_buffer(x), make_buffer(1) }};
+            return fit::unpack(sum_fronts())(std::move(a)); 
+        }
+    );
+}
+
+// Here the baseline is the left fold done by compress
+FIT_BENCHMARK_CASE("compress_tree/compress")
+{
+    return fit::bench::compare(
+        [](int x) { return sum_16(fit::compress(add_f()), x); },
+        [](int x) { return sum_16(fit::compress_tree(add_f()), x); }
+    );
+}
+
+FIT_BENCHMARK_CASE("repeat(n)")
+{
+    return fit::bench::compare(
+        [](int x) { return int(lcg_loop(x, ((x >> 8) & 31) + 1) & 0xffff); },
+        [](int x) { return int(fit::repeat(((x >> 8) & 31) + 1)(lcg_step())(unsigned(x)) & 0xffff); }
+    );
+}
+
+FIT_BENCHMARK_CASE("repeat(unroll<4>(n))")
+{
+    return fit::bench::compare(
+        [](int x) { return int(lcg_loop(x, ((x >> 8) & 31) + 1) & 0xffff); },
+        [](int x) { return int(fit::repeat(fit::unroll<4>(((x >> 8) & 31) + 1))(lcg_step())(unsigned(x)) & 0xffff); }
+    );
+}
+
+FIT_BENCHMARK_CASE("repeat_while(limit<64>)")
+{
+    return fit::bench::compare(
+        [](int x) { return int(lcg_while_loop(unsigned(x) | 1) & 0xffff); },
+        [](int x) { return int(fit::repeat_while(fit::limit<64>(low_bits_set()))(lcg_step())(unsigned(x) | 1) & 0xffff); }
+    );
+}
+
+FIT_BENCHMARK_CASE("repeat_while(unroll<4>)")
+{
+    return fit::bench::compare(
+        [](int x) { return int(lcg_while_loop(unsigned(x) | 1) & 0xffff); },
+        [](int x) { return int(fit::repeat_while(fit::limit<64>(fit::unroll<4>(low_bits_set())))(lcg_step())(unsigned(x) | 1) & 0xffff); }
+    );
+}
+
+FIT_BENCHMARK_CASE("iterate.take(16)")
+{
+    return fit::bench::compare(
+        [](int x) 
+        { 
+            unsigned state = x;
+            unsigned sum = 0;
+            for(int i = 0;i < 16;i++, state = lcg_step()(state)) sum += state >> 16;
+            return int(sum & 0xffff);
+        },
+        [](int x) 
+        { 
+            unsigned sum = 0;
+            for(unsigned state: fit::iterate(lcg_step())(unsigned(x)).take(16)) sum += state >> 16;
+            return int(sum & 0xffff);
+        }
+    );
+}
+
+struct rotate_kernel
+{
+    template<int N>
+    unsigned operator()(std::integral_constant<int, N>, unsigned x) const
+    {
+        return (x << (N + 1)) | (x >> (31 - N));
+    }
+};
+
+unsigned rotate_switch(int n, unsigned x)
+{
+    rotate_kernel f;
+    switch(n)
+    {
+        case 0: return f(std::integral_constant<int, 0>(), x);
+        case 1: return f(std::integral_constant<int, 1>(), x);
+        case 2: return f(std::integral_constant<int, 2>(), x);
+        case 3: return f(std::integral_constant<int, 3>(), x);
+        case 4: return f(std::integral_constant<int, 4>(), x);
+        case 5: return f(std::integral_constant<int, 5>(), x);
+        case 6: return f(std::integral_constant<int, 6>(), x);
+        default: return f(std::integral_constant<int, 7>(), x);
+    }
+}
+
+// The integer comes from an LCG, so the branch can't be predicted
+FIT_BENCHMARK_CASE("dispatch<0, 7>")
+{
+    return fit::bench::compare(
+        [](int x) { return int(rotate_switch((lcg_step()(x) >> 16) & 7, x) & 0xffff); },
+        [](int x) { return int(fit::dispatch<0, 7>(rotate_kernel())((lcg_step()(x) >> 16) & 7, unsigned(x)) & 0xffff); }
+    );
+}
+
+FIT_BENCHMARK_CASE("dispatch<0, 7>.fallback")
+{
+    return fit::bench::compare(
+        [](int x) { return int(rotate_switch((lcg_step()(x) >> 16) & 7, x) & 0xffff); },
+        [](int x) { return int(fit::dispatch<0, 7>(rotate_kernel(), fit::always(0u))((lcg_step()(x) >> 16) & 7, unsigned(x)) & 0xffff); }
+    );
+}
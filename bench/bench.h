@@ -0,0 +1,147 @@
+#ifndef GUARD_BENCH_H
+#define GUARD_BENCH_H
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#ifndef FIT_BENCH_LABEL
+#define FIT_BENCH_LABEL ""
+#endif
+
+#define FIT_BENCH_PP_CAT(x, y) FIT_BENCH_PP_PRIMITIVE_CAT(x, y)
+#define FIT_BENCH_PP_PRIMITIVE_CAT(x, y) x ## y
+
+// Keeps a function from being inlined, so calls through a type-erased
+// parameter can't be devirtualized
+#if defined(__GNUC__) || defined(__clang__)
+#define FIT_BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define FIT_BENCH_NOINLINE __declspec(noinline)
+#else
+#define FIT_BENCH_NOINLINE
+#endif
+
+namespace fit { namespace bench {
+
+// Keeps the compiler from optimizing away a value that is otherwise unused
+template<class T>
+inline void do_not_optimize(T& x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+r,m"(x) : : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<volatile char*>(&x);
+#endif
+}
+
+// Returns an int the compiler can't see through, so loops can't be folded
+inline int opaque(int x)
+{
+    do_not_optimize(x);
+    return x;
+}
+
+typedef std::function<double(long)> timer;
+
+// Runs `x = f(x)` in a loop and returns the best time per call in
+// nanoseconds over several runs
+template<class F>
+double ns_per_call(const F& f, long iterations)
+{
+    typedef std::chrono::high_resolution_clock clock;
+    double best = std::numeric_limits<double>::max();
+    for(int run = 0; run < 3; run++)
+    {
+        int x = opaque(run);
+        auto start = clock::now();
+        for(long i = 0; i < iterations; i++)
+        {
+            x = f(x);
+            do_not_optimize(x);
+        }
+        auto stop = clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count() / iterations;
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+template<class F>
+timer make_timer(F f)
+{
+    return [f](long iterations) { return ns_per_call(f, iterations); };
+}
+
+struct comparison
+{
+    timer baseline;
+    timer adaptor;
+};
+
+// Compare a hand-written function against the equivalent Fit adaptor. Both
+// must take an int and return an int.
+template<class Baseline, class Adaptor>
+comparison compare(Baseline b, Adaptor a)
+{
+    return { make_timer(b), make_timer(a) };
+}
+
+// Compare functions that do much more work per call, so they are run for
+// `scale` times fewer iterations
+template<class Baseline, class Adaptor>
+comparison compare(Baseline b, Adaptor a, long scale)
+{
+    auto baseline = make_timer(b);
+    auto adaptor = make_timer(a);
+    return {
+        [baseline, scale](long iterations) { return baseline(iterations / scale + 1); },
+        [adaptor, scale](long iterations) { return adaptor(iterations / scale + 1); }
+    };
+}
+
+struct bench_case
+{
+    std::string name;
+    std::function<comparison()> make;
+};
+
+static std::vector<bench_case> bench_cases;
+
+struct auto_register
+{
+    auto_register(std::string name, std::function<comparison()> make)
+    {
+        bench_cases.push_back({ name, make });
+    }
+};
+
+#define FIT_DETAIL_BENCHMARK_CASE(id, name) \
+static fit::bench::comparison id(); \
+static fit::bench::auto_register FIT_BENCH_PP_CAT(id, _register) = fit::bench::auto_register(name, &id); \
+static fit::bench::comparison id()
+
+#define FIT_BENCHMARK_CASE(name) FIT_DETAIL_BENCHMARK_CASE(FIT_BENCH_PP_CAT(bench_, __LINE__), name)
+
+}}
+
+int main(int argc, char const *argv[])
+{
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000000;
+    std::printf("%-24s %12s %12s %8s  [%s]\n", "case", "baseline(ns)", "fit(ns)", "ratio", FIT_BENCH_LABEL);
+    for(const auto& bc: fit::bench::bench_cases)
+    {
+        auto c = bc.make();
+        double baseline = c.baseline(iterations);
+        double adaptor = c.adaptor(iterations);
+        std::printf("%-24s %12.3f %12.3f %8.2f\n", bc.name.c_str(), baseline, adaptor, adaptor / baseline);
+    }
+    return 0;
+}
+
+#endif
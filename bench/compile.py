@@ -0,0 +1,448 @@
+#!/usr/bin/env python
+#=============================================================================
+#    Copyright (c) 2015 Paul Fultz II
+#    compile.py
+#    Distributed under the Boost Software License, Version 1.0. (See accompanying
+#    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#=============================================================================
+#
+# Compile-time benchmarks. Each case is a translation unit template that is
+# instantiated at growing sizes and compiled with the given compiler. For
+# every compile the wall time, the peak resident memory of the compiler and,
+# when the compiler supports `-ftime-trace`, the number of template
+# instantiations are recorded. The results are printed as a table and can be
+# written to a csv file, so regressions in the headers can be quantified.
+#
+#     python bench/compile.py --cxx g++ --flags="-std=c++14 -O0" --case seq --sizes 16 256 1024
+#
+# The `bench-compile` target runs all the cases with the compiler and flags
+# that are used to build the tests.
+
+import argparse
+import csv
+import json
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+cases = {}
+
+def case(name, sizes):
+    def decorator(f):
+        cases[name] = (f, sizes)
+        return f
+    return decorator
+
+def comma_list(f, n):
+    return ', '.join(f(i) for i in range(n))
+
+@case('seq', [16, 256, 1024])
+def bench_seq(n):
+    return '''
+#include <fit/detail/seq.h>
+
+template<int... Ns>
+constexpr int sum(fit::detail::seq<Ns...>)
+{{
+    return sizeof...(Ns);
+}}
+
+static_assert(sum(fit::detail::gens<{n}>::type()) == {n}, "");
+static_assert(sum(fit::detail::gens<{n} - 1>::type()) == {n} - 1, "");
+
+int main() {{}}
+'''.format(n=n)
+
+# Reference: the one-element-per-step recursion that `gens` used to have
+@case('seq_linear', [16, 256, 1024])
+def bench_seq_linear(n):
+    return '''
+template<int ...>
+struct seq {{}};
+
+template<int N, int ...S>
+struct gens : gens<N-1, N-1, S...> {{}};
+
+template<int ...S>
+struct gens<0, S...>
+{{
+  typedef seq<S...> type;
+}};
+
+template<int... Ns>
+constexpr int sum(seq<Ns...>)
+{{
+    return sizeof...(Ns);
+}}
+
+static_assert(sum(gens<{n}>::type()) == {n}, "");
+static_assert(sum(gens<{n} - 1>::type()) == {n} - 1, "");
+
+int main() {{}}
+'''.format(n=n)
+
+count_f = '''
+struct count_f
+{
+    template<class... Ts>
+    constexpr int operator()(Ts&&...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+'''
+
+increment_f = '''
+struct increment_f
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x + 1;
+    }
+};
+'''
+
+tag_f = '''
+template<int N>
+struct tag
+{};
+
+template<int N>
+struct tag_f
+{
+    constexpr int operator()(tag<N>) const
+    {
+        return N;
+    }
+};
+'''
+
+@case('pack', [16, 64, 256])
+def bench_pack(n):
+    return '''
+#include <fit/pack.h>
+{count_f}
+int main()
+{{
+    auto p = fit::pack({xs});
+    return p(count_f()) == {n} ? 0 : 1;
+}}
+'''.format(n=n, count_f=count_f, xs=comma_list(str, n))
+
+@case('pack_join', [4, 16, 64])
+def bench_pack_join(n):
+    return '''
+#include <fit/pack.h>
+{count_f}
+int main()
+{{
+    auto p = fit::pack_join({packs});
+    return p(count_f()) == {n} ? 0 : 1;
+}}
+'''.format(n=n, count_f=count_f, packs=comma_list(lambda i: 'fit::pack({0})'.format(i), n))
+
+@case('conditional', [8, 32, 128])
+def bench_conditional(n):
+    return '''
+#include <fit/conditional.h>
+{tag_f}
+int main()
+{{
+    auto f = fit::conditional({fs});
+    return f(tag<{last}>()) == {last} ? 0 : 1;
+}}
+'''.format(tag_f=tag_f, last=n-1, fs=comma_list(lambda i: 'tag_f<{0}>()'.format(i), n))
+
+# Calls every alternative, as a dispatcher does, so each call site has to
+# find its own function
+@case('conditional_calls', [8, 32, 128])
+def bench_conditional_calls(n):
+    return '''
+#include <fit/conditional.h>
+{tag_f}
+int main()
+{{
+    auto f = fit::conditional({fs});
+    int sum = 0;
+    {calls}
+    return sum == {total} ? 0 : 1;
+}}
+'''.format(tag_f=tag_f, total=n*(n-1)//2, fs=comma_list(lambda i: 'tag_f<{0}>()'.format(i), n),
+        calls='\n    '.join('sum += f(tag<{0}>());'.format(i) for i in range(n)))
+
+@case('match', [8, 32, 100])
+def bench_match(n):
+    return '''
+#include <fit/match.h>
+{tag_f}
+int main()
+{{
+    auto f = fit::match({fs});
+    return f(tag<{last}>()) == {last} ? 0 : 1;
+}}
+'''.format(tag_f=tag_f, last=n-1, fs=comma_list(lambda i: 'tag_f<{0}>()'.format(i), n))
+
+# Calls every alternative, like a visitor, so each call site resolves the
+# overload against the whole set
+@case('match_calls', [8, 32, 100])
+def bench_match_calls(n):
+    return '''
+#include <fit/match.h>
+{tag_f}
+int main()
+{{
+    auto f = fit::match({fs});
+    int sum = 0;
+    {calls}
+    return sum == {total} ? 0 : 1;
+}}
+'''.format(tag_f=tag_f, total=n*(n-1)//2, fs=comma_list(lambda i: 'tag_f<{0}>()'.format(i), n),
+        calls='\n    '.join('sum += f(tag<{0}>());'.format(i) for i in range(n)))
+
+@case('compose', [8, 32, 128])
+def bench_compose(n):
+    return '''
+#include <fit/compose.h>
+{increment_f}
+int main()
+{{
+    auto f = fit::compose({fs});
+    return f(0) == {n} ? 0 : 1;
+}}
+'''.format(n=n, increment_f=increment_f, fs=comma_list(lambda i: 'increment_f()', n))
+
+@case('flow', [8, 32, 128])
+def bench_flow(n):
+    return '''
+#include <fit/flow.h>
+{increment_f}
+int main()
+{{
+    auto f = fit::flow({fs});
+    return f(0) == {n} ? 0 : 1;
+}}
+'''.format(n=n, increment_f=increment_f, fs=comma_list(lambda i: 'increment_f()', n))
+
+sum_f = '''
+struct sum_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+'''
+
+@case('compress', [16, 64, 256])
+def bench_compress(n):
+    return '''
+#include <fit/compress.h>
+{sum_f}
+int main()
+{{
+    return fit::compress(sum_f())({xs}) == {total} ? 0 : 1;
+}}
+'''.format(sum_f=sum_f, total=n*(n-1)//2, xs=comma_list(str, n))
+
+@case('compress_tree', [16, 64, 256])
+def bench_compress_tree(n):
+    return '''
+#include <fit/compress_tree.h>
+{sum_f}
+int main()
+{{
+    return fit::compress_tree(sum_f())({xs}) == {total} ? 0 : 1;
+}}
+'''.format(sum_f=sum_f, total=n*(n-1)//2, xs=comma_list(str, n))
+
+@case('repeat', [64, 1024, 8192])
+def bench_repeat(n):
+    return '''
+#include <fit/repeat.h>
+{increment_f}
+int main()
+{{
+    auto f = fit::repeat(std::integral_constant<int, {n}>())(increment_f());
+    return f(0) == {n} ? 0 : 1;
+}}
+'''.format(n=n, increment_f=increment_f)
+
+# Reference: the one-call-per-step recursion that `repeat` used to have
+@case('repeat_linear', [64, 512, 1024])
+def bench_repeat_linear(n):
+    return '''
+#include <fit/returns.h>
+#include <utility>
+{increment_f}
+template<int N>
+struct repeater
+{{
+    template<class F, class T>
+    constexpr auto operator()(const F& f, T&& x) const FIT_RETURNS
+    (
+        repeater<N-1>()(f, f(std::forward<T>(x)))
+    );
+}};
+
+template<>
+struct repeater<0>
+{{
+    template<class F, class T>
+    constexpr T operator()(const F&, T&& x) const
+    {{
+        return x;
+    }}
+}};
+
+int main()
+{{
+    return repeater<{n}>()(increment_f(), 0) == {n} ? 0 : 1;
+}}
+'''.format(n=n, increment_f=increment_f)
+
+@case('args', [16, 64, 256])
+def bench_args(n):
+    return '''
+#include <fit/args.h>
+
+int main()
+{{
+    return fit::args(std::integral_constant<int, {n}>())({xs}) == {last} ? 0 : 1;
+}}
+'''.format(n=n, last=n-1, xs=comma_list(str, n))
+
+@case('placeholders', [4, 16, 64])
+def bench_placeholders(n):
+    return '''
+#include <fit/placeholders.h>
+
+int main()
+{{
+    using fit::_1;
+    using fit::_2;
+    auto f = {expr};
+    return f(0, 1) == {n} ? 0 : 1;
+}}
+'''.format(n=n, expr='(' * n + '_1' + ' + _2)' * n)
+
+def supports_flag(args, flag):
+    tmp = tempfile.mkdtemp(prefix='fit-bench-')
+    try:
+        src = os.path.join(tmp, 'empty.cpp')
+        with open(src, 'w') as f:
+            f.write('int main() {}\n')
+        cmd = [args.cxx, flag, '-c', src, '-o', os.path.join(tmp, 'empty.o')]
+        p = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        out, _ = p.communicate()
+        return p.returncode == 0 and len(out) == 0
+    finally:
+        shutil.rmtree(tmp, ignore_errors=True)
+
+def count_instantiations(trace_file):
+    try:
+        with open(trace_file) as f:
+            events = json.load(f).get('traceEvents', [])
+    except (IOError, ValueError):
+        return None
+    return sum(1 for e in events if e.get('name', '').startswith('Instantiate'))
+
+def peak_rss_kb():
+    try:
+        import resource
+    except ImportError:
+        return None
+    rss = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    if sys.platform == 'darwin':
+        rss = rss // 1024
+    return rss
+
+def run(cmd):
+    start = time.time()
+    p = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    out, _ = p.communicate()
+    elapsed = time.time() - start
+    return p.returncode, out, elapsed, peak_rss_kb()
+
+def compile_case(args, name, n, source):
+    tmp = tempfile.mkdtemp(prefix='fit-bench-')
+    try:
+        src = os.path.join(tmp, '{0}_{1}.cpp'.format(name, n))
+        obj = os.path.join(tmp, '{0}_{1}.o'.format(name, n))
+        with open(src, 'w') as f:
+            f.write(source)
+        cmd = [args.cxx] + shlex.split(args.flags) + ['-I', args.include, '-c', src, '-o', obj]
+        if args.time_trace:
+            cmd += ['-ftime-trace', '-ftime-trace-granularity=0']
+        returncode, out, elapsed, rss = run(cmd)
+        if returncode != 0 and args.verbose:
+            sys.stderr.write(out.decode('utf-8', 'replace'))
+        instantiations = None
+        if args.time_trace and returncode == 0:
+            instantiations = count_instantiations(os.path.splitext(obj)[0] + '.json')
+        return {
+            'case': name,
+            'size': n,
+            'status': 'ok' if returncode == 0 else 'failed',
+            'time': elapsed,
+            'rss_kb': rss,
+            'instantiations': instantiations
+        }
+    finally:
+        shutil.rmtree(tmp, ignore_errors=True)
+
+def format_optional(x):
+    return '-' if x is None else str(x)
+
+fields = ['case', 'size', 'status', 'time', 'rss_kb', 'instantiations']
+
+def main():
+    parser = argparse.ArgumentParser(description='Fit compile-time benchmarks')
+    parser.add_argument('--cxx', default=os.environ.get('CXX', 'c++'))
+    parser.add_argument('--include', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+    parser.add_argument('--flags', default='-std=c++14', help='Compiler flags, as a single string')
+    parser.add_argument('--case', nargs='*', dest='cases', default=sorted(cases.keys()), choices=sorted(cases.keys()))
+    parser.add_argument('--sizes', nargs='*', type=int)
+    parser.add_argument('--output', help='Write the results to this csv file')
+    parser.add_argument('--verbose', action='store_true')
+    args = parser.parse_args()
+    args.time_trace = supports_flag(args, '-ftime-trace')
+
+    # Each compile is run in a fresh interpreter child so the peak resident
+    # memory reported by the kernel belongs to that compile alone
+    if os.environ.get('FIT_BENCH_CHILD'):
+        result = compile_case(args, args.cases[0], args.sizes[0], cases[args.cases[0]][0](args.sizes[0]))
+        sys.stdout.write(json.dumps(result))
+        return
+
+    results = []
+    print('{0:<16} {1:>6} {2:>8} {3:>10} {4:>10} {5:>14}'.format('case', 'size', 'status', 'time(s)', 'rss(kb)', 'instantiations'))
+    for name in args.cases:
+        gen, sizes = cases[name]
+        for n in args.sizes or sizes:
+            cmd = [sys.executable, os.path.abspath(__file__),
+                '--cxx', args.cxx, '--include', args.include, '--flags=' + args.flags,
+                '--case', name, '--sizes', str(n)]
+            if args.verbose:
+                cmd.append('--verbose')
+            env = dict(os.environ, FIT_BENCH_CHILD='1')
+            out = subprocess.check_output(cmd, env=env)
+            r = json.loads(out.decode('utf-8'))
+            results.append(r)
+            print('{0:<16} {1:>6} {2:>8} {3:>10.3f} {4:>10} {5:>14}'.format(
+                r['case'], r['size'], r['status'], r['time'], format_optional(r['rss_kb']), format_optional(r['instantiations'])))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            writer = csv.DictWriter(f, fieldnames=fields)
+            writer.writeheader()
+            for r in results:
+                writer.writerow(dict((k, '' if r[k] is None else r[k]) for k in fields))
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,173 @@
+#include <fit/fix_memo.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include "bench.h"
+
+// Each call solves a whole problem with a fresh cache, so the timers run
+// fewer iterations
+template<class F>
+fit::bench::timer make_problem_timer(F f)
+{
+    return [f](long iterations) { return fit::bench::ns_per_call(f, iterations / 1000 + 1); };
+}
+
+// Strings of 24 letters that depend on the seed, so every call does the work
+static std::string make_string(unsigned seed)
+{
+    std::string s(24, 'a');
+    for(auto& c:s)
+    {
+        seed = seed * 1103515245u + 12345u;
+        c = 'a' + (seed >> 16) % 4;
+    }
+    return s;
+}
+
+struct edit_distance_t
+{
+    const std::string* a;
+    const std::string* b;
+
+    template<class Self>
+    int operator()(Self self, int i, int j) const
+    {
+        if (i == 0) return j;
+        if (j == 0) return i;
+        int cost = (*a)[i-1] == (*b)[j-1] ? 0 : 1;
+        return std::min(std::min(self(i-1, j) + 1, self(i, j-1) + 1), self(i-1, j-1) + cost);
+    }
+};
+
+// The hand-written memoization the adaptor replaces
+struct edit_distance_memo
+{
+    const std::string& a;
+    const std::string& b;
+    std::unordered_map<int, int> cache;
+
+    int operator()(int i, int j)
+    {
+        if (i == 0) return j;
+        if (j == 0) return i;
+        int key = i * 64 + j;
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+        int cost = a[i-1] == b[j-1] ? 0 : 1;
+        int r = std::min(std::min((*this)(i-1, j) + 1, (*this)(i, j-1) + 1), (*this)(i-1, j-1) + cost);
+        cache.emplace(key, r);
+        return r;
+    }
+};
+
+// Counts the paths through a grid, going right or down, where some cells are
+// blocked depending on the seed. The diagonal is never blocked, so there is
+// always a path
+struct grid_paths_t
+{
+    unsigned seed;
+
+    bool blocked(int i, int j) const
+    {
+        return i != j && ((unsigned(i * 64 + j) * 2654435761u + seed) >> 29) == 0;
+    }
+
+    template<class Self>
+    long long operator()(Self self, int i, int j) const
+    {
+        if (i < 0 || j < 0 || blocked(i, j)) return 0;
+        if (i == 0 && j == 0) return 1;
+        return self(i-1, j) + self(i, j-1);
+    }
+};
+
+struct grid_paths_memo
+{
+    grid_paths_t grid;
+    std::unordered_map<int, long long> cache;
+
+    long long operator()(int i, int j)
+    {
+        if (i < 0 || j < 0 || grid.blocked(i, j)) return 0;
+        if (i == 0 && j == 0) return 1;
+        int key = i * 64 + j;
+        auto it = cache.find(key);
+        if (it != cache.end()) return it->second;
+        long long r = (*this)(i-1, j) + (*this)(i, j-1);
+        cache.emplace(key, r);
+        return r;
+    }
+};
+
+template<class Policy>
+static fit::bench::comparison edit_distance_case()
+{
+    return fit::bench::comparison{
+        make_problem_timer([](int x)
+        {
+            std::string a = make_string(x), b = make_string(x + 1);
+            return x + edit_distance_memo{a, b, {}}(24, 24);
+        }),
+        make_problem_timer([](int x)
+        {
+            std::string a = make_string(x), b = make_string(x + 1);
+            return x + fit::fix_memo<int(int, int), Policy>(edit_distance_t{&a, &b})(24, 24);
+        })
+    };
+}
+
+template<class Policy>
+static fit::bench::comparison grid_paths_case()
+{
+    return fit::bench::comparison{
+        make_problem_timer([](int x)
+        {
+            return x + 1 + int(grid_paths_memo{grid_paths_t{unsigned(x)}, {}}(32, 32) & 0xffff);
+        }),
+        make_problem_timer([](int x)
+        {
+            return x + 1 + int(fit::fix_memo<long long(int, int), Policy>(grid_paths_t{unsigned(x)})(32, 32) & 0xffff);
+        })
+    };
+}
+
+// The baseline is always a hand-written memoization with an unordered_map
+FIT_BENCHMARK_CASE("edit/unordered_map")
+{
+    return edit_distance_case<fit::memo_unordered_map>();
+}
+
+FIT_BENCHMARK_CASE("edit/flat_map")
+{
+    return edit_distance_case<fit::memo_flat_map>();
+}
+
+FIT_BENCHMARK_CASE("edit/dense")
+{
+    return edit_distance_case<fit::memo_dense<25, 25>>();
+}
+
+FIT_BENCHMARK_CASE("edit/sharded")
+{
+    return edit_distance_case<fit::memo_sharded<>>();
+}
+
+FIT_BENCHMARK_CASE("grid/unordered_map")
+{
+    return grid_paths_case<fit::memo_unordered_map>();
+}
+
+FIT_BENCHMARK_CASE("grid/flat_map")
+{
+    return grid_paths_case<fit::memo_flat_map>();
+}
+
+FIT_BENCHMARK_CASE("grid/dense")
+{
+    return grid_paths_case<fit::memo_dense<33, 33>>();
+}
+
+FIT_BENCHMARK_CASE("grid/sharded")
+{
+    return grid_paths_case<fit::memo_sharded<>>();
+}
@@ -0,0 +1,69 @@
+#include <fit/function_ref.h>
+#include <fit/capture.h>
+#include <fit/compose.h>
+#include <fit/partial.h>
+#include <functional>
+#include "bench.h"
+
+struct sum4
+{
+    long operator()(long a, long b, long c, long x) const
+    {
+        return a + b * 3 + c * 5 + x;
+    }
+};
+
+// The closures hold three longs, which is more than std::function keeps
+// without allocating
+FIT_BENCH_NOINLINE int call_function(const std::function<long(long)>& f, int x)
+{
+    return int(f(x) & 0xffff);
+}
+
+FIT_BENCH_NOINLINE int call_function_ref(fit::function_ref<long(long)> f, int x)
+{
+    return int(f(x) & 0xffff);
+}
+
+template<class Make>
+fit::bench::comparison compare_closure(Make make)
+{
+    return fit::bench::compare(
+        [make](int x) { return call_function(make(x), x); },
+        [make](int x) { return call_function_ref(make(x), x); }
+    );
+}
+
+FIT_BENCHMARK_CASE("capture")
+{
+    return compare_closure([](int x) { return fit::capture(long(x), 2L, long(x >> 3))(sum4()); });
+}
+
+FIT_BENCHMARK_CASE("partial")
+{
+    return compare_closure([](int x) { return fit::partial(sum4())(long(x), 2L, long(x >> 3)); });
+}
+
+FIT_BENCHMARK_CASE("compose")
+{
+    return compare_closure([](int x)
+    {
+        long a = x, b = 2, c = x >> 3;
+        return fit::compose(
+            [a](long y) { return y + a; },
+            [b](long y) { return y * b; },
+            [c](long y) { return y - c; }
+        );
+    });
+}
+
+// The closure is made once, so this is only the cost of the call
+FIT_BENCHMARK_CASE("call")
+{
+    static const auto f = fit::capture(1L, 2L, 3L)(sum4());
+    static const std::function<long(long)> sf = f;
+    return fit::bench::compare(
+        [](int x) { return call_function(sf, x); },
+        [](int x) { return call_function_ref(f, x); }
+    );
+}
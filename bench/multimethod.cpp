@@ -0,0 +1,120 @@
+#include <fit/multimethod.h>
+#include <array>
+#include <memory>
+#include "bench.h"
+
+struct shape
+{
+    virtual int sides() const = 0;
+    virtual ~shape()
+    {}
+};
+
+struct triangle : shape
+{
+    int sides() const { return 3; }
+};
+
+struct square : shape
+{
+    int sides() const { return 4; }
+};
+
+struct pentagon : shape
+{
+    int sides() const { return 5; }
+};
+
+struct hexagon : shape
+{
+    int sides() const { return 6; }
+};
+
+// The shapes are picked with an LCG, so the branches can't be predicted
+static std::array<std::unique_ptr<shape>, 256> make_shapes()
+{
+    std::array<std::unique_ptr<shape>, 256> r;
+    unsigned seed = 1;
+    for(auto& s:r)
+    {
+        seed = seed * 1103515245u + 12345u;
+        switch((seed >> 16) % 4)
+        {
+            case 0: s.reset(new triangle()); break;
+            case 1: s.reset(new square()); break;
+            case 2: s.reset(new pentagon()); break;
+            default: s.reset(new hexagon()); break;
+        }
+    }
+    return r;
+}
+
+static const std::array<std::unique_ptr<shape>, 256> shapes = make_shapes();
+
+static const auto sides = fit::multimethod<const shape>(
+    [](const triangle&) { return 3; },
+    [](const square&) { return 4; },
+    [](const pentagon&) { return 5; },
+    [](const hexagon&) { return 6; }
+);
+
+// Double dispatch by trying each pair of types in turn, which is what the
+// multimethod replaces
+template<class T, class U>
+static int collide_as(const T&, const U&)
+{
+    return T().sides() * 8 + U().sides();
+}
+
+template<class T>
+static int collide_second(const T& x, const shape& y)
+{
+    if (auto p = dynamic_cast<const triangle*>(&y)) return collide_as(x, *p);
+    if (auto p = dynamic_cast<const square*>(&y)) return collide_as(x, *p);
+    if (auto p = dynamic_cast<const pentagon*>(&y)) return collide_as(x, *p);
+    if (auto p = dynamic_cast<const hexagon*>(&y)) return collide_as(x, *p);
+    return 0;
+}
+
+static int collide_casts(const shape& x, const shape& y)
+{
+    if (auto p = dynamic_cast<const triangle*>(&x)) return collide_second(*p, y);
+    if (auto p = dynamic_cast<const square*>(&x)) return collide_second(*p, y);
+    if (auto p = dynamic_cast<const pentagon*>(&x)) return collide_second(*p, y);
+    if (auto p = dynamic_cast<const hexagon*>(&x)) return collide_second(*p, y);
+    return 0;
+}
+
+template<class T, class U>
+static int collide_overload(const T& x, const U& y)
+{
+    return collide_as(x, y);
+}
+
+static const auto collide = fit::multimethod<const shape>(
+    &collide_overload<triangle, triangle>, &collide_overload<triangle, square>,
+    &collide_overload<triangle, pentagon>, &collide_overload<triangle, hexagon>,
+    &collide_overload<square, triangle>, &collide_overload<square, square>,
+    &collide_overload<square, pentagon>, &collide_overload<square, hexagon>,
+    &collide_overload<pentagon, triangle>, &collide_overload<pentagon, square>,
+    &collide_overload<pentagon, pentagon>, &collide_overload<pentagon, hexagon>,
+    &collide_overload<hexagon, triangle>, &collide_overload<hexagon, square>,
+    &collide_overload<hexagon, pentagon>, &collide_overload<hexagon, hexagon>
+);
+
+// A virtual function is the lower bound for a single dynamic argument
+FIT_BENCHMARK_CASE("multimethod/1")
+{
+    return fit::bench::compare(
+        [](int x) { return x + shapes[x & 255]->sides(); },
+        [](int x) { return x + sides(*shapes[x & 255]); }
+    );
+}
+
+FIT_BENCHMARK_CASE("multimethod/2")
+{
+    return fit::bench::compare(
+        [](int x) { return x + collide_casts(*shapes[x & 255], *shapes[(x >> 8) & 255]); },
+        [](int x) { return x + collide(*shapes[x & 255], *shapes[(x >> 8) & 255]); }
+    );
+}
@@ -0,0 +1,49 @@
+#include <fit/parallel_compress.h>
+#include <numeric>
+#include <thread>
+#include "bench.h"
+
+struct sum_f
+{
+    template<class T, class U>
+    T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+static const std::vector<double>& data()
+{
+    static std::vector<double> v(1 << 20, 0.5);
+    return v;
+}
+
+// Each call folds a million elements, so the timers run fewer iterations
+template<class F>
+fit::bench::timer make_range_timer(F f)
+{
+    return [f](long iterations) { return fit::bench::ns_per_call(f, iterations / 10000 + 1); };
+}
+
+// The baseline is always the sequential fold, so the ratio shows the speedup
+// with each number of threads
+static void add_scaling_case(std::size_t n)
+{
+    fit::bench::auto_register("parallel_compress/" + std::to_string(n), [n]
+    {
+        return fit::bench::comparison{
+            make_range_timer([](int x) { return x + int(std::accumulate(data().begin(), data().end(), 0.0, sum_f())); }),
+            make_range_timer([n](int x) { return x + int(fit::parallel_compress(sum_f(), 0.0)(data(), fit::parallel_policy(n))); })
+        };
+    });
+}
+
+static struct register_scaling
+{
+    register_scaling()
+    {
+        std::size_t cores = std::thread::hardware_concurrency();
+        for(std::size_t n = 1; n < cores; n *= 2) add_scaling_case(n);
+        add_scaling_case(cores > 0 ? cores : 1);
+    }
+} register_scaling_;
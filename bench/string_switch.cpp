@@ -0,0 +1,99 @@
+#include <fit/string_switch.h>
+#include "bench.h"
+
+#if FIT_HAS_STRING_SWITCH
+#include <array>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+template<int N>
+struct op
+{
+    int operator()(int x) const
+    {
+        return x * (N + 1) + N;
+    }
+};
+
+struct unknown_op
+{
+    int operator()(const std::string&, int x) const
+    {
+        return -x;
+    }
+};
+
+static const char* names[] = {
+    "get", "set", "add", "sub", "mul", "div", "push", "pop",
+    "load", "store", "open", "close", "read", "write", "send", "recv",
+    // Not commands
+    "put", "erase"
+};
+
+// The hand-written table that string_switch replaces
+static std::unordered_map<std::string, std::function<int(int)>> make_map()
+{
+    std::unordered_map<std::string, std::function<int(int)>> m;
+    m["get"] = op<0>(); m["set"] = op<1>(); m["add"] = op<2>(); m["sub"] = op<3>();
+    m["mul"] = op<4>(); m["div"] = op<5>(); m["push"] = op<6>(); m["pop"] = op<7>();
+    m["load"] = op<8>(); m["store"] = op<9>(); m["open"] = op<10>(); m["close"] = op<11>();
+    m["read"] = op<12>(); m["write"] = op<13>(); m["send"] = op<14>(); m["recv"] = op<15>();
+    return m;
+}
+
+static int call_map(const std::unordered_map<std::string, std::function<int(int)>>& m, const std::string& s, int x)
+{
+    auto it = m.find(s);
+    if (it == m.end()) return unknown_op()(s, x);
+    return it->second(x);
+}
+
+static const auto commands = fit::string_switch(
+    fit::string_case("get", op<0>()), fit::string_case("set", op<1>()),
+    fit::string_case("add", op<2>()), fit::string_case("sub", op<3>()),
+    fit::string_case("mul", op<4>()), fit::string_case("div", op<5>()),
+    fit::string_case("push", op<6>()), fit::string_case("pop", op<7>()),
+    fit::string_case("load", op<8>()), fit::string_case("store", op<9>()),
+    fit::string_case("open", op<10>()), fit::string_case("close", op<11>()),
+    fit::string_case("read", op<12>()), fit::string_case("write", op<13>()),
+    fit::string_case("send", op<14>()), fit::string_case("recv", op<15>()),
+    unknown_op()
+);
+
+// The names are picked with an LCG, so the branches can't be predicted
+static std::array<std::string, 256> make_messages()
+{
+    std::array<std::string, 256> r;
+    unsigned seed = 1;
+    for(auto& m:r)
+    {
+        seed = seed * 1103515245u + 12345u;
+        m = names[(seed >> 16) % (sizeof(names) / sizeof(names[0]))];
+    }
+    return r;
+}
+
+static const std::array<std::string, 256> messages = make_messages();
+
+FIT_BENCHMARK_CASE("string_switch")
+{
+    static const auto m = make_map();
+    return fit::bench::compare(
+        [](int x) { return call_map(m, messages[x & 255], x) & 0xffff; },
+        [](int x) { return commands(messages[x & 255], x) & 0xffff; }
+    );
+}
+
+// Only four of the names, so the branches are mostly predicted, and this is
+// closer to the cost of the lookup itself
+FIT_BENCHMARK_CASE("string_switch.predicted")
+{
+    static const auto m = make_map();
+    return fit::bench::compare(
+        [](int x) { return call_map(m, messages[x & 3], x) & 0xffff; },
+        [](int x) { return commands(messages[x & 3], x) & 0xffff; }
+    );
+}
+
+#endif
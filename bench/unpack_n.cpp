@@ -0,0 +1,66 @@
+#include <fit/unpack_n.h>
+#include "bench.h"
+
+struct sum_all
+{
+    int operator()() const
+    {
+        return 0;
+    }
+
+    template<class... Ts>
+    int operator()(int x, Ts... xs) const
+    {
+        return x + sum_all()(xs...);
+    }
+};
+
+static int data[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+int switch_4(const int* p, int n)
+{
+    sum_all f;
+    switch(n)
+    {
+        case 0: return f();
+        case 1: return f(p[0]);
+        case 2: return f(p[0], p[1]);
+        case 3: return f(p[0], p[1], p[2]);
+        default: return f(p[0], p[1], p[2], p[3]);
+    }
+}
+
+int switch_8(const int* p, int n)
+{
+    sum_all f;
+    switch(n)
+    {
+        case 0: return f();
+        case 1: return f(p[0]);
+        case 2: return f(p[0], p[1]);
+        case 3: return f(p[0], p[1], p[2]);
+        case 4: return f(p[0], p[1], p[2], p[3]);
+        case 5: return f(p[0], p[1], p[2], p[3], p[4]);
+        case 6: return f(p[0], p[1], p[2], p[3], p[4], p[5]);
+        case 7: return f(p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+        default: return f(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+    }
+}
+
+// The size of the range changes on every call, so neither version can be
+// predicted perfectly
+FIT_BENCHMARK_CASE("unpack_n<4>")
+{
+    return fit::bench::compare(
+        [](int x) { return switch_4(data, x & 3) & 0xffff; },
+        [](int x) { return fit::unpack_n<4>(sum_all())(data, x & 3) & 0xffff; }
+    );
+}
+
+FIT_BENCHMARK_CASE("unpack_n<8>")
+{
+    return fit::bench::compare(
+        [](int x) { return switch_8(data, x & 7) & 0xffff; },
+        [](int x) { return fit::unpack_n<8>(sum_all())(data, x & 7) & 0xffff; }
+    );
+}
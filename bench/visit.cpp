@@ -0,0 +1,88 @@
+#include <fit/visit.h>
+#include "bench.h"
+
+#if FIT_HAS_STD_VARIANT
+#include <fit/match.h>
+#include <array>
+
+template<int N>
+struct alt
+{
+    int value;
+};
+
+typedef std::variant<alt<0>, alt<1>, alt<2>, alt<3>, alt<4>, alt<5>, alt<6>, alt<7>> message;
+
+struct handle
+{
+    template<int N>
+    int operator()(alt<N> a) const
+    {
+        return a.value * (N + 1);
+    }
+
+    template<int N, int M>
+    int operator()(alt<N> a, alt<M> b) const
+    {
+        return a.value * (N + 1) + b.value * (M + 3);
+    }
+};
+
+template<std::size_t... Ns>
+static message make_message(std::size_t i, std::index_sequence<Ns...>)
+{
+    static const message alternatives[] = { alt<Ns>{int(Ns)}... };
+    return alternatives[i];
+}
+
+// The alternatives are picked with an LCG, so the branches can't be
+// predicted
+static std::array<message, 256> make_messages()
+{
+    std::array<message, 256> r;
+    unsigned seed = 1;
+    for(auto& m:r)
+    {
+        seed = seed * 1103515245u + 12345u;
+        m = make_message((seed >> 16) % 8, std::make_index_sequence<8>());
+    }
+    return r;
+}
+
+static const std::array<message, 256> messages = make_messages();
+
+FIT_BENCHMARK_CASE("visit")
+{
+    return fit::bench::compare(
+        [](int x) { return x + std::visit(handle(), messages[x & 255]); },
+        [](int x) { return x + fit::visit(handle())(messages[x & 255]); }
+    );
+}
+
+FIT_BENCHMARK_CASE("visit/match")
+{
+    static const auto f = fit::match(
+        [](alt<0> a) { return a.value; },
+        [](alt<1> a) { return a.value * 2; },
+        [](alt<2> a) { return a.value * 3; },
+        [](alt<3> a) { return a.value * 4; },
+        [](alt<4> a) { return a.value * 5; },
+        [](alt<5> a) { return a.value * 6; },
+        [](alt<6> a) { return a.value * 7; },
+        [](alt<7> a) { return a.value * 8; }
+    );
+    return fit::bench::compare(
+        [](int x) { return x + std::visit(f, messages[x & 255]); },
+        [](int x) { return x + fit::visit(f)(messages[x & 255]); }
+    );
+}
+
+FIT_BENCHMARK_CASE("visit/8x8")
+{
+    return fit::bench::compare(
+        [](int x) { return x + std::visit(handle(), messages[x & 255], messages[(x >> 8) & 255]); },
+        [](int x) { return x + fit::visit(handle())(messages[x & 255], messages[(x >> 8) & 255]); }
+    );
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include <fit/detail/delegate.h>
 #include <fit/detail/move.h>
 #include <fit/detail/holder.h>
+#include <fit/detail/is_final.h>
 
 /// alias
 /// =====
@@ -115,9 +116,9 @@ struct alias_tag<alias<T, Tag>>
 template<class T, class Tag=void>
 struct alias_inherit 
 #if (defined(__GNUC__) && !defined (__clang__))
-: std::conditional<(std::is_class<T>::value), T, alias<T>>::type
+: std::conditional<(std::is_class<T>::value && !detail::is_final<T>::value), T, alias<T>>::type
 #else
-: T
+: std::conditional<(!detail::is_final<T>::value), T, alias<T>>::type
 #endif
 {
     FIT_INHERIT_CONSTRUCTOR(alias_inherit, T)
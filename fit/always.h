@@ -10,6 +10,8 @@
 
 #include <fit/detail/unwrap.h>
 #include <fit/detail/static_const_var.h>
+#include <fit/detail/is_final.h>
+#include <type_traits>
 
 /// always
 /// ======
@@ -69,7 +71,7 @@
 
 namespace fit { namespace detail {
 
-template<class T>
+template<class T, bool=(std::is_empty<T>::value && !is_final<T>::value)>
 struct always_base
 {
     T x;
@@ -88,6 +90,23 @@ struct always_base
     }
 };
 
+// An empty value is inherited, so it takes no space, unless it is final
+template<class T>
+struct always_base<T, true> : private T
+{
+    constexpr always_base()
+    {}
+
+    constexpr always_base(T x) : T(x)
+    {}
+
+    template<class... As>
+    constexpr T operator()(As&&...) const
+    {
+        return static_cast<const T&>(*this);
+    }
+};
+
 #if FIT_NO_CONSTEXPR_VOID
 #define FIT_ALWAYS_VOID_RETURN fit::detail::always_base<void>::void_
 #else
@@ -95,7 +114,7 @@ struct always_base
 #endif
 
 template<>
-struct always_base<void>
+struct always_base<void, false>
 {
     
     constexpr always_base()
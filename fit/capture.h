@@ -113,6 +113,8 @@ struct capture_invoke : detail::callable_base<F>, Pack
 
     FIT_RETURNS_CLASS(capture_invoke);
 
+    // The captured values are copied into the call, unless the closure is an
+    // rvalue, in which case they are moved
     template<class... Ts>
     constexpr FIT_SFINAE_RESULT
     (
@@ -122,7 +124,7 @@ struct capture_invoke : detail::callable_base<F>, Pack
         >::type,
         id_<detail::callable_base<F>&&>
     ) 
-    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    operator()(Ts&&... xs) FIT_CONST_LVALUE_QUALIFIER FIT_SFINAE_RETURNS
     (
         fit::pack_join
         (
@@ -131,6 +133,27 @@ struct capture_invoke : detail::callable_base<F>, Pack
         )
         (FIT_RETURNS_C_CAST(detail::callable_base<F>&&)(FIT_CONST_THIS->base_function(xs...)))
     );
+
+#if FIT_HAS_RVALUE_THIS
+    template<class... Ts>
+    constexpr FIT_SFINAE_RESULT
+    (
+        typename result_of<decltype(fit::pack_join), 
+            id_<Pack&&>, 
+            result_of<decltype(fit::pack_forward), id_<Ts>...> 
+        >::type,
+        id_<detail::callable_base<F>&&>
+    ) 
+    operator()(Ts&&... xs) && FIT_SFINAE_RETURNS
+    (
+        fit::pack_join
+        (
+            FIT_RETURNS_C_CAST(Pack&&)(FIT_CONST_THIS->get_pack(xs...)), 
+            fit::pack_forward(fit::forward<Ts>(xs)...)
+        )
+        (FIT_RETURNS_C_CAST(detail::callable_base<F>&&)(FIT_CONST_THIS->base_function(xs...)))
+    );
+#endif
 };
 
 template<class Pack>
@@ -140,9 +163,19 @@ struct capture_pack : Pack
 
     FIT_RETURNS_CLASS(capture_pack);
 
-    // TODO: Should use rvalue ref qualifier
     template<class F>
-    constexpr auto operator()(F f) const FIT_SFINAE_RETURNS
+    constexpr auto operator()(F f) FIT_CONST_LVALUE_QUALIFIER FIT_SFINAE_RETURNS
+    (
+        capture_invoke<F, Pack>(fit::move(f), 
+            FIT_CONST_LVALUE_CAST(Pack)(
+                FIT_RETURNS_STATIC_CAST(const Pack&)(*always(FIT_CONST_THIS)(f))
+            )
+        )
+    );
+
+#if FIT_HAS_RVALUE_THIS
+    template<class F>
+    constexpr auto operator()(F f) && FIT_SFINAE_RETURNS
     (
         capture_invoke<F, Pack>(fit::move(f), 
             FIT_RETURNS_C_CAST(Pack&&)(
@@ -150,6 +183,7 @@ struct capture_pack : Pack
             )
         )
     );
+#endif
 };
 
 struct make_capture_pack_f
@@ -98,7 +98,7 @@ struct combine_adaptor_base<seq<Ns...>, F, Gs...>
     operator()(Ts&&... xs) const FIT_SFINAE_MANUAL_RETURNS
     (
         (FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->base_function(xs...)))
-            (alias_value<pack_tag<seq<Ns>, Gs...>, Gs>(*FIT_CONST_THIS, xs)(fit::forward<Ts>(xs))...)
+            (pack_value<Ns, Gs>(FIT_RETURNS_STATIC_CAST(const base_type&)(*FIT_CONST_THIS), xs)(fit::forward<Ts>(xs))...)
     );
 };
 
@@ -0,0 +1,191 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    compress_tree.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_COMPRESS_TREE_H
+#define FIT_GUARD_COMPRESS_TREE_H
+
+/// compress_tree
+/// =============
+/// 
+/// Description
+/// -----------
+/// 
+/// The `compress_tree` function adaptor uses a binary function to fold the
+/// arguments passed to the function, like `compress`, except the arguments
+/// are combined pairwise as a balanced tree instead of from left to right.
+/// Additionally, an optional initial state can be provided, which is used as
+/// the leftmost argument.
+/// 
+/// The binary function must be associative, in which case the result is the
+/// same as `compress`, since the order of the arguments is kept. The depth of
+/// the template instantiations is logarithmic in the number of arguments,
+/// rather than linear, and the two halves of the tree don't depend on each
+/// other, so they can be evaluated in parallel by the processor.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     template<class F, class State>
+///     constexpr compress_tree_adaptor<F, State> compress_tree(F f, State s);
+/// 
+///     template<class F>
+///     constexpr compress_tree_adaptor<F> compress_tree(F f);
+/// 
+/// Semantics
+/// ---------
+/// 
+///     assert(compress_tree(f, z)() == z);
+///     assert(compress_tree(f, z)(xs...) == compress_tree(f)(z, xs...));
+///     assert(compress_tree(f)(x) == x);
+///     assert(compress_tree(f)(x1, x2, x3, x4) == f(f(x1, x2), f(x3, x4)));
+/// 
+/// Requirements
+/// ------------
+/// 
+/// State must be:
+/// 
+/// * CopyConstructible
+/// 
+/// F must be:
+/// 
+/// * [BinaryCallable](concepts.md#binarycallable)
+/// * MoveConstructible
+/// 
+/// Example
+/// -------
+/// 
+///     struct max_f
+///     {
+///         template<class T, class U>
+///         constexpr T operator()(T x, U y) const
+///         {
+///             return x > y ? x : y;
+///         }
+///     };
+///     assert(fit::compress_tree(max_f())(2, 3, 4, 5) == 5);
+/// 
+
+#include <fit/pack.h>
+#include <fit/always.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/compressed_pair.h>
+#include <fit/detail/move.h>
+#include <fit/detail/make.h>
+#include <fit/detail/static_const_var.h>
+
+namespace fit { namespace detail {
+
+// Folds the N arguments starting at Lo, which are held by reference in a pack
+template<int Lo, int N>
+struct tree_fold
+{
+    template<class F, class P>
+    constexpr FIT_SFINAE_MANUAL_RESULT(const F&, 
+        result_of<tree_fold<Lo, N/2>, id_<const F&>, id_<const P&>>, 
+        result_of<tree_fold<Lo + N/2, N - N/2>, id_<const F&>, id_<const P&>>
+    )
+    operator()(const F& f, const P& p) const FIT_SFINAE_MANUAL_RETURNS
+    (
+        f(tree_fold<Lo, N/2>()(f, p), tree_fold<Lo + N/2, N - N/2>()(f, p))
+    );
+};
+
+template<int Lo>
+struct tree_fold<Lo, 1>
+{
+    template<class F, class P>
+    constexpr auto operator()(const F&, const P& p) const FIT_RETURNS
+    (
+        pack_ref<Lo>(p)
+    );
+};
+
+template<class F, class... Ts>
+constexpr auto compress_tree_fold(const F& f, Ts&&... xs) FIT_RETURNS
+(
+    tree_fold<0, sizeof...(Ts)>()(f, pack_forward(fit::forward<Ts>(xs)...))
+);
+
+template<class F, class State>
+constexpr State compress_tree_fold(const F&, State&& state) 
+{
+    return fit::forward<State>(state);
+}
+
+struct compress_tree_f
+{
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (
+        compress_tree_fold(fit::forward<Ts>(xs)...)
+    );
+};
+
+}
+
+template<class F, class State=void>
+struct compress_tree_adaptor
+: detail::compressed_pair<detail::callable_base<F>, State>
+{
+    typedef detail::compressed_pair<detail::callable_base<F>, State> base_type;
+    FIT_INHERIT_CONSTRUCTOR(compress_tree_adaptor, base_type)
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr State get_state(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class... Ts>
+    constexpr FIT_SFINAE_RESULT(detail::compress_tree_f, id_<const detail::callable_base<F>&>, id_<State>, id_<Ts>...)
+    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        detail::compress_tree_f()(
+            FIT_MANGLE_CAST(const detail::callable_base<F>&)(this->base_function(xs...)), 
+            FIT_MANGLE_CAST(State)(this->get_state(xs...)), 
+            fit::forward<Ts>(xs)...
+        )
+    )
+};
+
+
+template<class F>
+struct compress_tree_adaptor<F, void>
+: detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(compress_tree_adaptor, detail::callable_base<F>)
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class T, class... Ts>
+    constexpr FIT_SFINAE_RESULT(detail::compress_tree_f, id_<const detail::callable_base<F>&>, id_<T>, id_<Ts>...)
+    operator()(T&& x, Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        detail::compress_tree_f()(
+            FIT_MANGLE_CAST(const detail::callable_base<F>&)(this->base_function(x, xs...)), 
+            fit::forward<T>(x),
+            fit::forward<Ts>(xs)...
+        )
+    )
+};
+
+FIT_DECLARE_STATIC_VAR(compress_tree, detail::make<compress_tree_adaptor>);
+
+}
+
+#endif
@@ -68,75 +68,190 @@
 /// to how the function is chosen.
 
 #include <fit/reveal.h>
+#include <fit/is_callable.h>
 #include <fit/detail/callable_base.h>
 #include <fit/detail/delegate.h>
+#include <fit/detail/holder.h>
 #include <fit/detail/join.h>
 #include <fit/detail/make.h>
+#include <fit/detail/seq.h>
 #include <fit/detail/static_const_var.h>
 
 namespace fit {
 
 namespace detail {
 
-template<int N>
-struct rank : rank<N-1>
+constexpr int conditional_find(const bool* xs, int first, int last);
+
+constexpr int conditional_find_right(const bool* xs, int left, int middle, int last)
+{
+    return left < middle ? left : conditional_find(xs, middle, last);
+}
+
+// Finds the first true value by splitting the range in halves, so the
+// recursion is only logarithmic in the number of functions
+constexpr int conditional_find(const bool* xs, int first, int last)
+{
+    return (last - first) == 1 ? 
+        (xs[first] ? first : last) : 
+        conditional_find_right(xs, conditional_find(xs, first, first + (last - first) / 2), first + (last - first) / 2, last);
+}
+
+template<bool... Bs>
+struct conditional_first
+{
+    // The last value is always true, so the index is the number of
+    // functions when none of them can be called
+    static constexpr bool values[] = { Bs..., true };
+    static constexpr int value = conditional_find(values, 0, sizeof...(Bs) + 1);
+};
+
+template<bool... Bs>
+constexpr bool conditional_first<Bs...>::values[];
+
+constexpr int conditional_larger(int x, int y)
+{
+    return x > y ? x : y;
+}
+
+// Also split in halves, like conditional_find
+constexpr int conditional_max(const int* xs, int first, int last)
+{
+    return (last - first) == 1 ? 
+        xs[first] : 
+        conditional_larger(conditional_max(xs, first, first + (last - first) / 2), conditional_max(xs, first + (last - first) / 2, last));
+}
+
+// How deeply conditionals are nested in a function, which is zero for a
+// function that doesn't inherit from a conditional
+template<class F, class=void>
+struct conditional_depth
+: std::integral_constant<int, 0>
 {};
 
-template<>
-struct rank<0>
+template<class F>
+struct conditional_depth<F, typename holder<typename F::fit_conditional_depth>::type>
+: F::fit_conditional_depth
 {};
 
-template<int N, class...Fs> struct conditional_adaptor_base;
- 
-template<int N, class F, class...Fs>
-struct conditional_adaptor_base<N, F, Fs...> : conditional_adaptor_base<N, F>, conditional_adaptor_base<N-1, Fs...>
+// A conditional is one level deeper than the deepest conditional among its
+// functions
+template<class... Fs>
+struct conditional_level
 {
-    typedef conditional_adaptor_base<N-1, Fs...> base;
-    typedef conditional_adaptor_base<N, F> single_base;
+    static constexpr int depths[] = { conditional_depth<Fs>::value..., 0 };
+    static constexpr int value = conditional_max(depths, 0, sizeof...(Fs) + 1) + 1;
+};
+
+template<class... Fs>
+constexpr int conditional_level<Fs...>::depths[];
 
-    FIT_INHERIT_DEFAULT(conditional_adaptor_base, single_base, base);
+// Used to default construct the functions that are not given to the
+// constructor
+struct conditional_default
+{};
 
-    template<class X, class... Xs, FIT_ENABLE_IF_CONVERTIBLE(X, single_base), FIT_ENABLE_IF_CONSTRUCTIBLE(base, Xs...)>
-    constexpr conditional_adaptor_base(X&& f1, Xs&& ... fs) 
-    : single_base(fit::forward<X>(f1)), base(fit::forward<Xs>(fs)...)
-    {}
+struct conditional_leaves
+{};
 
-    using base::operator();
-    using single_base::operator();
+template<class F, class... Fs>
+struct conditional_head
+{
+    typedef F type;
 };
 
-template<int N, class F>
-struct conditional_adaptor_base<N, F> : detail::callable_base<F>
+// Every function is held in its own base, which is tagged by its index, so
+// functions of the same type don't clash. It is also tagged by the level of
+// the conditional, so the bases of a nested conditional don't clash with the
+// bases of the conditional that holds it.
+template<int N, class F, int Level>
+struct conditional_leaf : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(conditional_leaf, detail::callable_base<F>);
+
+    constexpr conditional_leaf(conditional_default) : detail::callable_base<F>()
+    {}
+};
+
+// The base is found by overload resolution, where only the index and the
+// level are given, so the function is reached without searching through a
+// chain of bases
+template<int N, int Level, class F>
+constexpr const detail::callable_base<F>& conditional_get(const conditional_leaf<N, F, Level>& x)
+{
+    return x;
+}
+
+template<int N, int Level, class F>
+constexpr detail::callable_base<F>&& conditional_get(conditional_leaf<N, F, Level>&& x)
+{
+    return static_cast<detail::callable_base<F>&&>(x);
+}
+
+template<int Level, class Seq, class... Fs> 
+struct conditional_adaptor_base;
+
+template<int Level, int... Ns, class... Fs>
+struct conditional_adaptor_base<Level, seq<Ns...>, Fs...> 
+: conditional_leaf<Ns, Fs, Level>...
 {
-    typedef detail::callable_base<F> base;
+    typedef std::integral_constant<int, Level> fit_conditional_depth;
+
+    FIT_INHERIT_DEFAULT(conditional_adaptor_base, Fs...);
+
+    // The functions that are not given are default constructed, so the
+    // arguments are padded to one for every function
+    template<class X, class... Xs, typename std::enable_if<(sizeof...(Xs) < sizeof...(Fs)), int>::type = 0,
+        FIT_ENABLE_IF_CONVERTIBLE(X, detail::callable_base<typename conditional_head<Fs...>::type>)>
+    constexpr conditional_adaptor_base(X&& x, Xs&&... xs) 
+    : conditional_adaptor_base(typename gens<sizeof...(Fs) - sizeof...(Xs) - 1>::type(), fit::forward<X>(x), fit::forward<Xs>(xs)...)
+    {}
+
+    template<int... Ms, class... Xs>
+    constexpr conditional_adaptor_base(seq<Ms...>, Xs&&... xs) 
+    : conditional_adaptor_base(conditional_leaves(), fit::forward<Xs>(xs)..., ((void)Ms, conditional_default())...)
+    {}
 
-    FIT_INHERIT_CONSTRUCTOR(conditional_adaptor_base, detail::callable_base<F>);
+    template<class... Xs>
+    constexpr conditional_adaptor_base(conditional_leaves, Xs&&... xs) 
+    : conditional_leaf<Ns, Fs, Level>(fit::forward<Xs>(xs))...
+    {}
 
+    // The index of the first function that can be called, computed with a
+    // single expansion over the functions
     template<class... Ts>
-    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
-    {
-        return always_ref(*this)(xs...);
-    }
+    struct index
+    : conditional_first<can_be_called<const detail::callable_base<Fs>&, Ts...>::value...>
+    {};
 
-    FIT_RETURNS_CLASS(conditional_adaptor_base);
+    template<class... Ts>
+    struct rvalue_index
+    : conditional_first<can_be_called<detail::callable_base<Fs>&&, Ts...>::value...>
+    {};
+};
 
+template<int Level>
+struct conditional_adaptor_base<Level, seq<>>
+{
     template<class... Ts>
-    constexpr FIT_SFINAE_RESULT(const detail::callable_base<F>&, id_<Ts>...) 
-    operator()(rank<N>, Ts&&... xs) const FIT_SFINAE_RETURNS
-    (
-        (FIT_MANGLE_CAST(const detail::callable_base<F>&)(FIT_CONST_THIS->base_function(xs...)))(fit::forward<Ts>(xs)...)
-    );
+    struct index
+    : std::integral_constant<int, 0>
+    {};
+
+    template<class... Ts>
+    struct rvalue_index
+    : std::integral_constant<int, 0>
+    {};
 };
 
 }
 
 template<class... Fs>
 struct conditional_adaptor 
-: detail::conditional_adaptor_base<sizeof...(Fs), Fs...>
+: detail::conditional_adaptor_base<detail::conditional_level<Fs...>::value, typename detail::gens<sizeof...(Fs)>::type, Fs...>
 {
     typedef conditional_adaptor fit_rewritable_tag;
-    typedef detail::conditional_adaptor_base<sizeof...(Fs), Fs...> base;
-    typedef detail::rank<sizeof...(Fs)> rank_type;
+    typedef detail::conditional_adaptor_base<detail::conditional_level<Fs...>::value, typename detail::gens<sizeof...(Fs)>::type, Fs...> base;
 
     FIT_INHERIT_CONSTRUCTOR(conditional_adaptor, base);
 
@@ -152,12 +267,24 @@ struct conditional_adaptor
 
     FIT_RETURNS_CLASS(conditional_adaptor);
 
-    template<class... Ts>
-    constexpr FIT_SFINAE_RESULT(const base&, id_<rank_type>, id_<Ts>...) 
-    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    template<class... Ts, int N=base::template index<Ts...>::value, 
+        typename std::enable_if<(N < sizeof...(Fs)), int>::type = 0>
+    constexpr auto operator()(Ts&&... xs) FIT_CONST_LVALUE_QUALIFIER FIT_RETURNS
     (
-        (FIT_MANGLE_CAST(const base&)(FIT_CONST_THIS->base_function(xs...)))(rank_type(), fit::forward<Ts>(xs)...)
+        detail::conditional_get<N, detail::conditional_level<Fs...>::value>(FIT_MANGLE_CAST(const base&)(FIT_CONST_THIS->base_function(xs...)))
+            (fit::forward<Ts>(xs)...)
     );
+
+#if FIT_HAS_RVALUE_THIS
+    // An rvalue conditional calls the function it picks as an rvalue
+    template<class... Ts, int N=base::template rvalue_index<Ts...>::value, 
+        typename std::enable_if<(N < sizeof...(Fs)), int>::type = 0>
+    constexpr auto operator()(Ts&&... xs) && FIT_RETURNS
+    (
+        detail::conditional_get<N, detail::conditional_level<Fs...>::value>(FIT_RETURNS_C_CAST(base&&)(FIT_CONST_THIS->base_function(xs...)))
+            (fit::forward<Ts>(xs)...)
+    );
+#endif
 };
 
 FIT_DECLARE_STATIC_VAR(conditional, detail::make<conditional_adaptor>);
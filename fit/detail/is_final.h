@@ -0,0 +1,31 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    is_final.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DETAIL_IS_FINAL_H
+#define FIT_GUARD_DETAIL_IS_FINAL_H
+
+#include <type_traits>
+
+namespace fit { namespace detail {
+
+// A final class can't be inherited, so it can't be stored as an empty base.
+// std::is_final is only in C++14, so the intrinsic is used before that.
+#if __cplusplus >= 201402L
+template<class T>
+struct is_final
+: std::is_final<T>
+{};
+#else
+template<class T>
+struct is_final
+: std::integral_constant<bool, __is_final(T)>
+{};
+#endif
+
+}}
+
+#endif
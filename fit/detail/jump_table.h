@@ -0,0 +1,63 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    jump_table.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DETAIL_JUMP_TABLE_H
+#define FIT_GUARD_DETAIL_JUMP_TABLE_H
+
+#include <fit/detail/forward.h>
+#include <fit/detail/seq.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace fit { namespace detail {
+
+// Calls the Nth case of the invoker, which is a class with a static
+// `apply<N>(xs...)` for every index in the table, converting the result to R
+template<class Invoker, int N, class R, class... Ts>
+constexpr R jump_table_invoke(Ts&&... xs)
+{
+    return Invoker::template apply<N>(fit::forward<Ts>(xs)...);
+}
+
+template<class Invoker, class R, class Seq, class... Ts>
+struct jump_table_entries;
+
+template<class Invoker, class R, int... Ns, class... Ts>
+struct jump_table_entries<Invoker, R, seq<Ns...>, Ts...>
+{
+    typedef R (*entry_type)(Ts&&...);
+    static constexpr entry_type table[] = { &jump_table_invoke<Invoker, Ns, R, Ts...>... };
+};
+
+template<class Invoker, class R, int... Ns, class... Ts>
+constexpr typename jump_table_entries<Invoker, R, seq<Ns...>, Ts...>::entry_type
+jump_table_entries<Invoker, R, seq<Ns...>, Ts...>::table[];
+
+// A table of function pointers, with one entry for each index, which is
+// generated at compile-time, so a runtime index is dispatched with a single
+// indirect call. The result is the common type of every case, unless another
+// type is asked for, such as one that also covers a fallback.
+template<class Invoker, class Seq, class... Ts>
+struct jump_table;
+
+template<class Invoker, int... Ns, class... Ts>
+struct jump_table<Invoker, seq<Ns...>, Ts...>
+{
+    typedef typename std::common_type<
+        decltype(Invoker::template apply<Ns>(std::declval<Ts>()...))...
+    >::type result_type;
+
+    template<class R=result_type>
+    static constexpr R call(std::size_t i, Ts&&... xs)
+    {
+        return jump_table_entries<Invoker, R, seq<Ns...>, Ts...>::table[i](fit::forward<Ts>(xs)...);
+    }
+};
+
+}}
+
+#endif
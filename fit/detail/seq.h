@@ -8,24 +8,90 @@
 #ifndef FIT_GUARD_FUNCTION_DETAIL_SEQ_H
 #define FIT_GUARD_FUNCTION_DETAIL_SEQ_H
 
+#ifndef FIT_HAS_MAKE_INTEGER_SEQ
+#if defined(__has_builtin)
+#if __has_builtin(__make_integer_seq)
+#define FIT_HAS_MAKE_INTEGER_SEQ 1
+#else
+#define FIT_HAS_MAKE_INTEGER_SEQ 0
+#endif
+#else
+#define FIT_HAS_MAKE_INTEGER_SEQ 0
+#endif
+#endif
 
-namespace fit { 
+#ifndef FIT_HAS_INTEGER_PACK
+#if defined(__GNUC__) && !defined (__clang__) && __GNUC__ >= 8
+#define FIT_HAS_INTEGER_PACK 1
+#else
+#define FIT_HAS_INTEGER_PACK 0
+#endif
+#endif
+
+namespace fit {
 
 namespace detail {
 
 template<int ...>
-struct seq {};
+struct seq
+{
+    typedef seq type;
+};
 
-template<int N, int ...S>
-struct gens : gens<N-1, N-1, S...> {};
+#if FIT_HAS_MAKE_INTEGER_SEQ
 
-template<int ...S>
-struct gens<0, S...> 
+template<class T, T... Ns>
+struct make_seq_builder
 {
-  typedef seq<S...> type;
+    typedef seq<Ns...> type;
 };
 
+template<int N>
+struct gens
+: __make_integer_seq<make_seq_builder, int, N>::type
+{};
+
+#elif FIT_HAS_INTEGER_PACK
+
+template<int N>
+struct gens
+: seq<__integer_pack(N)...>
+{};
+
+#else
+
+// Joins two sequences by shifting the second one by the size of the first,
+// so the sequence can be built by doubling, which keeps the instantiation
+// depth logarithmic in N.
+template<class S1, class S2>
+struct merge_seq;
+
+template<int... Xs, int... Ys>
+struct merge_seq<seq<Xs...>, seq<Ys...>>
+: seq<Xs..., (int(sizeof...(Xs))+Ys)...>
+{};
+
+template<int N>
+struct gens
+: merge_seq<
+    typename gens<N/2>::type,
+    typename gens<N - N/2>::type
+>::type
+{};
+
+template<>
+struct gens<0>
+: seq<>
+{};
+
+template<>
+struct gens<1>
+: seq<0>
+{};
+
+#endif
+
 }
 }
 
-#endif
\ No newline at end of file
+#endif
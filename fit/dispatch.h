@@ -0,0 +1,188 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    dispatch.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DISPATCH_H
+#define FIT_GUARD_DISPATCH_H
+
+/// dispatch
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `dispatch` function adaptor turns an integer known only at runtime
+/// into a `std::integral_constant`, so `dispatch<Lo, Hi>(f)(n, xs...)` calls
+/// `f(std::integral_constant<int, n>(), xs...)`, for `n` from `Lo` to `Hi`,
+/// inclusive. This lets functions that take an integral constant, such as
+/// `repeat` or `args`, be driven by a runtime value, instead of writing out a
+/// `switch` by hand.
+///
+/// The call is dispatched through a table with one entry for each integer
+/// in the range, which is generated at compile-time, so the cost of a call
+/// doesn't depend on the size of the range.
+///
+/// A fallback function can be given, which is called as `g(n, xs...)` when
+/// `n` is outside of the range. Without a fallback, `std::out_of_range` is
+/// thrown when `n` is outside of the range. The results must have a common
+/// type, which is what is returned.
+///
+/// Synopsis
+/// --------
+///
+///     template<int Lo, int Hi, class F>
+///     constexpr dispatch_adaptor<Lo, Hi, F> dispatch(F f);
+///
+///     template<int Lo, int Hi, class F, class G>
+///     constexpr dispatch_adaptor<Lo, Hi, F, G> dispatch(F f, G g);
+///
+/// Semantics
+/// ---------
+///
+///     assert(dispatch<Lo, Hi>(f)(n, xs...) == f(std::integral_constant<int, n>(), xs...));
+///     assert(dispatch<Lo, Hi>(f, g)(n, xs...) == (Lo <= n && n <= Hi ? f(std::integral_constant<int, n>(), xs...) : g(n, xs...)));
+///
+/// Requirements
+/// ------------
+///
+/// F and G must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct shift_left
+///     {
+///         template<int N>
+///         int operator()(std::integral_constant<int, N>, int x) const
+///         {
+///             return x << N;
+///         }
+///     };
+///
+///     assert(fit::dispatch<0, 7>(shift_left())(3, 1) == 8);
+///     assert(fit::dispatch<0, 7>(shift_left(), [](int, int x) { return x; })(9, 1) == 1);
+///
+
+#include <fit/always.h>
+#include <fit/returns.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/compressed_pair.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/jump_table.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+template<int Lo>
+struct dispatch_invoker
+{
+    template<int N, class F, class... Ts>
+    static constexpr auto apply(const F& f, Ts&&... xs) FIT_RETURNS
+    (
+        f(std::integral_constant<int, Lo + N>(), fit::forward<Ts>(xs)...)
+    );
+};
+
+template<int Lo, int Hi, class F, class... Ts>
+struct dispatch_table
+: jump_table<dispatch_invoker<Lo>, typename gens<Hi - Lo + 1>::type, const F&, Ts...>
+{};
+
+}
+
+template<int Lo, int Hi, class F, class Fallback=void>
+struct dispatch_adaptor
+: detail::compressed_pair<detail::callable_base<F>, detail::callable_base<Fallback>>
+{
+    static_assert(Lo <= Hi, "The range of dispatch is empty");
+    typedef detail::compressed_pair<detail::callable_base<F>, detail::callable_base<Fallback>> base_type;
+
+    FIT_INHERIT_CONSTRUCTOR(dispatch_adaptor, base_type);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr const detail::callable_base<Fallback>& base_fallback(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class... Ts>
+    struct table
+    : detail::dispatch_table<Lo, Hi, detail::callable_base<F>, Ts...>
+    {};
+
+    template<class... Ts>
+    struct result
+    : std::common_type<
+        typename table<Ts...>::result_type,
+        decltype(std::declval<const detail::callable_base<Fallback>&>()(0, std::declval<Ts>()...))
+    >
+    {};
+
+    template<class... Ts>
+    typename result<Ts&&...>::type operator()(int n, Ts&&... xs) const
+    {
+        typedef typename result<Ts&&...>::type result_type;
+        if (n < Lo || n > Hi) return this->base_fallback(xs...)(n, fit::forward<Ts>(xs)...);
+        return table<Ts&&...>::template call<result_type>(n - Lo, this->base_function(xs...), fit::forward<Ts>(xs)...);
+    }
+};
+
+template<int Lo, int Hi, class F>
+struct dispatch_adaptor<Lo, Hi, F, void> : detail::callable_base<F>
+{
+    static_assert(Lo <= Hi, "The range of dispatch is empty");
+
+    FIT_INHERIT_CONSTRUCTOR(dispatch_adaptor, detail::callable_base<F>);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts>
+    struct table
+    : detail::dispatch_table<Lo, Hi, detail::callable_base<F>, Ts...>
+    {};
+
+    template<class... Ts>
+    typename table<Ts&&...>::result_type operator()(int n, Ts&&... xs) const
+    {
+        typedef typename table<Ts&&...>::result_type result_type;
+        if (n < Lo || n > Hi) throw std::out_of_range("Integer is outside of the range for dispatch");
+        return table<Ts&&...>::template call<result_type>(n - Lo, this->base_function(xs...), fit::forward<Ts>(xs)...);
+    }
+};
+
+template<int Lo, int Hi, class F>
+constexpr dispatch_adaptor<Lo, Hi, F> dispatch(F f)
+{
+    return dispatch_adaptor<Lo, Hi, F>(fit::move(f));
+}
+
+template<int Lo, int Hi, class F, class G>
+constexpr dispatch_adaptor<Lo, Hi, F, G> dispatch(F f, G g)
+{
+    return dispatch_adaptor<Lo, Hi, F, G>(fit::move(f), fit::move(g));
+}
+
+}
+
+#endif
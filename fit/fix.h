@@ -17,9 +17,11 @@
 /// The `fix` function adaptor implements a fixed-point combinator. This can be
 /// used to write recursive functions. 
 /// 
-/// Note: Compilers are too eager to instantiate templates when using
-/// constexpr, which causes the compiler to reach its internal instantiation
-/// limit. So, unfortunately, `fix` cannot be used for `constexpr` functions.
+/// The `fix` function adaptor can be used for `constexpr` functions on
+/// compilers that support relaxed `constexpr`. Older compilers are too eager
+/// to instantiate templates when using constexpr, which causes the compiler to
+/// reach its internal instantiation limit, so there `fix` is not `constexpr`.
+/// This can be overridden by defining `FIT_FIX_HAS_CONSTEXPR`.
 /// 
 /// Synopsis
 /// --------
@@ -56,8 +58,18 @@
 #include <fit/detail/static_const_var.h>
 
 #ifndef FIT_FIX_HAS_CONSTEXPR
+#if defined(__clang__)
+#if __has_feature(cxx_relaxed_constexpr)
+#define FIT_FIX_HAS_CONSTEXPR 1
+#else
 #define FIT_FIX_HAS_CONSTEXPR 0
 #endif
+#elif defined(__GNUC__) && __GNUC__ >= 5 && __cplusplus >= 201402L
+#define FIT_FIX_HAS_CONSTEXPR 1
+#else
+#define FIT_FIX_HAS_CONSTEXPR 0
+#endif
+#endif
 
 #if FIT_FIX_HAS_CONSTEXPR
 #define FIT_FIX_CONSTEXPR constexpr
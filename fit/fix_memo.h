@@ -0,0 +1,369 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    fix_memo.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_FIX_MEMO_H
+#define FIT_GUARD_FUNCTION_FIX_MEMO_H
+
+/// fix_memo
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `fix_memo` function adaptor is a fixed-point combinator, like `fix`,
+/// that memoizes the function. The function is called with a reference to
+/// itself, and every call, including the recursive ones, first looks up the
+/// arguments in a cache, so each set of arguments is only computed once. This
+/// turns a recursive definition of a dynamic programming problem into an
+/// efficient one.
+///
+/// The signature of the function is given explicitly, as the arguments are
+/// converted to it, and the cache is keyed on the decayed types of the
+/// parameters. The cache is shared by the copies of the adaptor, and it lives
+/// as long as they do. The way the results are cached is selected by a
+/// policy:
+///
+/// * `memo_unordered_map`: A `std::unordered_map`. This is the default.
+/// * `memo_flat_map`: A hash table with open addressing and linear probing,
+///   stored in a single array. The parameters and the result must be default
+///   constructible.
+/// * `memo_dense<Ns...>`: An array indexed by the arguments, for integral
+///   parameters, where each parameter must be in `[0, N)`. Arguments outside
+///   of the bounds are computed without being cached. The result must be
+///   default constructible.
+/// * `memo_sharded<Shards>`: A set of `std::unordered_map`, each with its own
+///   mutex, so the function can be called from several threads. The function
+///   itself is called without holding a lock, so a result may be computed more
+///   than once when two threads ask for it at the same time.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Signature, class Policy=memo_unordered_map, class F>
+///     fix_memo_adaptor<F, Signature, Policy> fix_memo(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(fix_memo<R(Ts...)>(f)(xs...) == f(fix_memo<R(Ts...)>(f), xs...));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// The decayed parameter types must be:
+///
+/// * EqualityComparable
+/// * Hashable with `std::hash`
+///
+/// Example
+/// -------
+///
+///     struct fib
+///     {
+///         template<class Self>
+///         long long operator()(Self self, int n) const
+///         {
+///             return n < 2 ? n : self(n - 1) + self(n - 2);
+///         }
+///     };
+///
+///     assert(fit::fix_memo<long long(int)>(fib())(80) == 23416728348467685LL);
+///     assert(fit::fix_memo<long long(int), fit::memo_dense<81>>(fib())(80) == 23416728348467685LL);
+///
+
+#include <fit/always.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace fit {
+
+namespace detail {
+
+// Spreads the bits of a hash, since std::hash is often the identity for
+// integers
+inline std::size_t memo_mix(std::size_t h)
+{
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h;
+}
+
+template<class T>
+std::size_t memo_hash_combine(std::size_t seed, const T& x)
+{
+    return seed ^ (std::hash<T>()(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+struct memo_hash
+{
+    template<class Tuple, int... Ns>
+    static std::size_t apply(const Tuple& t, seq<Ns...>)
+    {
+        std::size_t seed = 0;
+        (void)std::initializer_list<int>{(seed = memo_hash_combine(seed, std::get<Ns>(t)), 0)...};
+        return seed;
+    }
+
+    template<class... Ts>
+    std::size_t operator()(const std::tuple<Ts...>& t) const
+    {
+        return apply(t, typename gens<sizeof...(Ts)>::type());
+    }
+};
+
+template<class Key, class R>
+struct memo_unordered_map_cache
+{
+    std::unordered_map<Key, R, memo_hash> map;
+
+    template<class Compute>
+    R get(const Key& key, Compute compute)
+    {
+        auto it = map.find(key);
+        if (it != map.end()) return it->second;
+        R r = compute();
+        map.emplace(key, r);
+        return r;
+    }
+};
+
+template<class Key, class R>
+struct memo_flat_map_cache
+{
+    struct slot
+    {
+        bool used;
+        Key key;
+        R value;
+
+        slot() : used(false), key(), value()
+        {}
+    };
+
+    std::vector<slot> slots;
+    std::size_t count;
+
+    memo_flat_map_cache() : slots(16), count(0)
+    {}
+
+    std::size_t find(const Key& key) const
+    {
+        std::size_t mask = slots.size() - 1;
+        std::size_t i = memo_mix(memo_hash()(key)) & mask;
+        while(slots[i].used && !(slots[i].key == key)) i = (i + 1) & mask;
+        return i;
+    }
+
+    void grow()
+    {
+        std::vector<slot> old(slots.size() * 2);
+        old.swap(slots);
+        for(auto& s:old) if (s.used) slots[this->find(s.key)] = fit::move(s);
+    }
+
+    template<class Compute>
+    R get(const Key& key, Compute compute)
+    {
+        std::size_t i = this->find(key);
+        if (slots[i].used) return slots[i].value;
+        R r = compute();
+        // The table may have grown while computing the result
+        if (2 * (count + 1) > slots.size()) this->grow();
+        i = this->find(key);
+        if (!slots[i].used)
+        {
+            slots[i].used = true;
+            slots[i].key = key;
+            slots[i].value = r;
+            count++;
+        }
+        return r;
+    }
+};
+
+template<class Key, class R, std::size_t... Ns>
+struct memo_dense_cache
+{
+    static_assert(std::tuple_size<Key>::value == sizeof...(Ns), "There must be a bound for every parameter");
+
+    std::vector<R> values;
+    std::vector<bool> filled;
+
+    static std::size_t size()
+    {
+        std::size_t n = 1;
+        for(std::size_t x:{Ns...}) n *= x;
+        return n;
+    }
+
+    memo_dense_cache() : values(size()), filled(size(), false)
+    {}
+
+    // Computes the index in row-major order, or returns false when an
+    // argument is out of bounds
+    template<int... Is>
+    static bool index(const Key& key, std::size_t& result, seq<Is...>)
+    {
+        const std::size_t bounds[] = { Ns... };
+        const long long xs[] = { static_cast<long long>(std::get<Is>(key))... };
+        result = 0;
+        for(std::size_t i = 0; i < sizeof...(Ns); i++)
+        {
+            if (xs[i] < 0 || static_cast<std::size_t>(xs[i]) >= bounds[i]) return false;
+            result = result * bounds[i] + static_cast<std::size_t>(xs[i]);
+        }
+        return true;
+    }
+
+    template<class Compute>
+    R get(const Key& key, Compute compute)
+    {
+        std::size_t i;
+        if (!index(key, i, typename gens<sizeof...(Ns)>::type())) return compute();
+        if (filled[i]) return values[i];
+        R r = compute();
+        values[i] = r;
+        filled[i] = true;
+        return r;
+    }
+};
+
+template<class Key, class R, std::size_t Shards>
+struct memo_sharded_cache
+{
+    struct shard
+    {
+        std::mutex m;
+        std::unordered_map<Key, R, memo_hash> map;
+    };
+
+    std::array<shard, Shards> shards;
+
+    template<class Compute>
+    R get(const Key& key, Compute compute)
+    {
+        shard& s = shards[memo_mix(memo_hash()(key)) % Shards];
+        {
+            std::lock_guard<std::mutex> lock(s.m);
+            auto it = s.map.find(key);
+            if (it != s.map.end()) return it->second;
+        }
+        R r = compute();
+        std::lock_guard<std::mutex> lock(s.m);
+        s.map.emplace(key, r);
+        return r;
+    }
+};
+
+}
+
+struct memo_unordered_map
+{
+    template<class Key, class R>
+    struct apply
+    {
+        typedef detail::memo_unordered_map_cache<Key, R> type;
+    };
+};
+
+struct memo_flat_map
+{
+    template<class Key, class R>
+    struct apply
+    {
+        typedef detail::memo_flat_map_cache<Key, R> type;
+    };
+};
+
+template<std::size_t... Ns>
+struct memo_dense
+{
+    template<class Key, class R>
+    struct apply
+    {
+        typedef detail::memo_dense_cache<Key, R, Ns...> type;
+    };
+};
+
+template<std::size_t Shards=16>
+struct memo_sharded
+{
+    static_assert(Shards > 0, "There must be at least one shard");
+    template<class Key, class R>
+    struct apply
+    {
+        typedef detail::memo_sharded_cache<Key, R, Shards> type;
+    };
+};
+
+template<class F, class Signature, class Policy=memo_unordered_map>
+struct fix_memo_adaptor;
+
+template<class F, class R, class... Args, class Policy>
+struct fix_memo_adaptor<F, R(Args...), Policy> : detail::callable_base<F>
+{
+    typedef std::tuple<typename std::decay<Args>::type...> key_type;
+    typedef typename Policy::template apply<key_type, R>::type cache_type;
+    typedef R result_type;
+
+    std::shared_ptr<cache_type> cache;
+
+    fix_memo_adaptor(F f) : detail::callable_base<F>(fit::move(f)), cache(std::make_shared<cache_type>())
+    {}
+
+    template<class... Ts>
+    const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    // Passed to the function as itself, which is cheap to copy
+    struct self
+    {
+        const fix_memo_adaptor* adaptor;
+
+        R operator()(Args... xs) const
+        {
+            return (*adaptor)(xs...);
+        }
+    };
+
+    R operator()(Args... xs) const
+    {
+        return cache->get(key_type(xs...), [&]
+        {
+            return this->base_function(xs...)(self{this}, xs...);
+        });
+    }
+};
+
+template<class Signature, class Policy=memo_unordered_map, class F>
+fix_memo_adaptor<F, Signature, Policy> fix_memo(F f)
+{
+    return fix_memo_adaptor<F, Signature, Policy>(fit::move(f));
+}
+
+}
+
+#endif
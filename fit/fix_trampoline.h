@@ -0,0 +1,241 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    fix_trampoline.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_FIX_TRAMPOLINE_H
+#define FIT_GUARD_FUNCTION_FIX_TRAMPOLINE_H
+
+/// fix_trampoline
+/// ==============
+///
+/// Description
+/// -----------
+///
+/// The `fix_trampoline` function adaptor is a fixed-point combinator, like
+/// `fix`, that recurses in constant stack space. Calling the self reference
+/// doesn't call the function, instead it returns a suspended call, which the
+/// function returns. The adaptor then resumes it in a loop. So the function
+/// returns a `trampoline_step`, which is either a suspended call or a final
+/// result, and which is implicitly constructible from the result.
+///
+/// For a recursive call that is not in tail position, the rest of the
+/// computation is given to the `then` member function of the suspended call,
+/// as a function that takes the result of the call and returns another step.
+/// These continuations are kept on the heap by the adaptor, so deep recursion
+/// doesn't overflow the stack, even with several recursive calls. Tail calls
+/// don't allocate, so they run at close to the speed of a loop.
+///
+/// The signature of the function is given explicitly, as the suspended calls
+/// store the arguments, converted to the decayed parameter types. The step
+/// type is available as `Self::step`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Signature, class F>
+///     fix_trampoline_adaptor<F, Signature> fix_trampoline(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(fix_trampoline<R(Ts...)>(f)(xs...) == f(fix_trampoline<R(Ts...)>(f), xs...));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// The result and the decayed parameter types must be:
+///
+/// * DefaultConstructible
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct sum_to
+///     {
+///         template<class Self>
+///         typename Self::step operator()(Self self, int n, long long acc) const
+///         {
+///             if (n == 0) return acc;
+///             return self(n - 1, acc + n);
+///         }
+///     };
+///
+///     struct sum_to_non_tail
+///     {
+///         template<class Self>
+///         typename Self::step operator()(Self self, int n) const
+///         {
+///             if (n == 0) return 0LL;
+///             return self(n - 1).then([n](long long r) -> typename Self::step { return n + r; });
+///         }
+///     };
+///
+///     assert(fit::fix_trampoline<long long(int, long long)>(sum_to())(1000000, 0) == 500000500000LL);
+///     assert(fit::fix_trampoline<long long(int)>(sum_to_non_tail())(1000000) == 500000500000LL);
+///
+
+#include <fit/always.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace fit {
+
+template<class R, class... Args>
+struct trampoline_step;
+
+namespace detail {
+
+// The continuations are type erased by hand, rather than with std::function,
+// so each one is a single allocation
+template<class Step, class R>
+struct trampoline_continuation
+{
+    virtual Step operator()(R x) = 0;
+    virtual ~trampoline_continuation()
+    {}
+};
+
+template<class Step, class R, class K>
+struct trampoline_then : trampoline_continuation<Step, R>
+{
+    K k;
+    trampoline_then(K x) : k(fit::move(x))
+    {}
+
+    Step operator()(R x)
+    {
+        return k(fit::move(x));
+    }
+};
+
+template<class Step, class R, class K>
+struct trampoline_chain : trampoline_continuation<Step, R>
+{
+    std::unique_ptr<trampoline_continuation<Step, R>> first;
+    K k;
+    trampoline_chain(std::unique_ptr<trampoline_continuation<Step, R>> f, K x) : first(fit::move(f)), k(fit::move(x))
+    {}
+
+    Step operator()(R x)
+    {
+        return (*first)(fit::move(x)).then(fit::move(k));
+    }
+};
+
+}
+
+template<class R, class... Args>
+struct trampoline_step
+{
+    typedef std::tuple<typename std::decay<Args>::type...> args_type;
+    typedef detail::trampoline_continuation<trampoline_step, R> continuation;
+
+    bool is_call;
+    R value;
+    args_type args;
+    // Kept behind a pointer, so tail calls only move a pointer
+    std::unique_ptr<continuation> next;
+
+    trampoline_step(R x) : is_call(false), value(fit::move(x)), args(), next()
+    {}
+
+    template<class... Ts>
+    static trampoline_step call(Ts&&... xs)
+    {
+        trampoline_step result{R()};
+        result.is_call = true;
+        result.args = args_type(fit::forward<Ts>(xs)...);
+        return result;
+    }
+
+    // Continues with the result of this step, which only runs the function
+    // right away when the step is already a result
+    template<class K>
+    trampoline_step then(K k) &&
+    {
+        if (!is_call) return k(fit::move(value));
+        if (next) next.reset(new detail::trampoline_chain<trampoline_step, R, K>(fit::move(next), fit::move(k)));
+        else next.reset(new detail::trampoline_then<trampoline_step, R, K>(fit::move(k)));
+        return fit::move(*this);
+    }
+};
+
+template<class F, class Signature>
+struct fix_trampoline_adaptor;
+
+template<class F, class R, class... Args>
+struct fix_trampoline_adaptor<F, R(Args...)> : detail::callable_base<F>
+{
+    typedef trampoline_step<R, Args...> step;
+    typedef R result_type;
+
+    FIT_INHERIT_CONSTRUCTOR(fix_trampoline_adaptor, detail::callable_base<F>);
+
+    template<class... Ts>
+    const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    // Passed to the function as itself, it suspends the call
+    struct self
+    {
+        typedef typename fix_trampoline_adaptor::step step;
+
+        step operator()(Args... xs) const
+        {
+            return step::call(fit::forward<Args>(xs)...);
+        }
+    };
+
+    template<int... Ns>
+    step resume(typename step::args_type& args, detail::seq<Ns...>) const
+    {
+        return this->base_function(args)(self(), std::get<Ns>(fit::move(args))...);
+    }
+
+    R operator()(Args... xs) const
+    {
+        std::vector<std::unique_ptr<typename step::continuation>> stack;
+        step s = this->base_function(xs...)(self(), fit::forward<Args>(xs)...);
+        for(;;)
+        {
+            if (s.is_call)
+            {
+                if (s.next) stack.push_back(fit::move(s.next));
+                s = this->resume(s.args, typename detail::gens<sizeof...(Args)>::type());
+            }
+            else if (stack.empty()) return fit::move(s.value);
+            else
+            {
+                std::unique_ptr<typename step::continuation> k = fit::move(stack.back());
+                stack.pop_back();
+                s = (*k)(fit::move(s.value));
+            }
+        }
+    }
+};
+
+template<class Signature, class F>
+fix_trampoline_adaptor<F, Signature> fix_trampoline(F f)
+{
+    return fix_trampoline_adaptor<F, Signature>(fit::move(f));
+}
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    function_ref.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_REF_H
+#define FIT_GUARD_FUNCTION_REF_H
+
+/// function_ref
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `function_ref` class is a reference to a function object with the
+/// signature `R(Ts...)`, so any function object, such as a Fit adaptor, can
+/// be passed to a function that is not a template. Unlike `std::function`,
+/// it doesn't copy or own the function object, so it never allocates. It is
+/// two pointers, one to the function object and one to a function that calls
+/// it, so it is trivially copyable, and calling it is a single indirect call.
+///
+/// As it doesn't own the function object, the function object must outlive
+/// the `function_ref`. So it is mostly useful as a parameter, where a
+/// temporary function object lives until the call returns.
+///
+/// Synopsis
+/// --------
+///
+///     template<class R, class... Ts>
+///     class function_ref<R(Ts...)>
+///     {
+///         template<class F>
+///         function_ref(F&& f);
+///
+///         R operator()(Ts... xs) const;
+///     };
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+///
+/// Example
+/// -------
+///
+///     int apply_twice(fit::function_ref<int(int)> f, int x)
+///     {
+///         return f(f(x));
+///     }
+///
+///     assert(apply_twice(fit::capture(1)(fit::_ + fit::_), 3) == 5);
+///
+
+#include <fit/apply.h>
+#include <fit/is_callable.h>
+#include <fit/detail/forward.h>
+#include <memory>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+template<class R, class T>
+struct function_ref_returns
+: std::is_convertible<T, R>
+{};
+
+template<class T>
+struct function_ref_returns<void, T>
+: std::true_type
+{};
+
+// A function is referred to by a function pointer, since a function pointer
+// can't be converted to an object pointer
+union function_ref_target
+{
+    void* object;
+    void (*function)();
+};
+
+template<class F, class=void>
+struct function_ref_access
+{
+    typedef typename std::remove_reference<F>::type type;
+
+    static function_ref_target make(type& f)
+    {
+        function_ref_target t;
+        t.object = const_cast<void*>(static_cast<const volatile void*>(std::addressof(f)));
+        return t;
+    }
+
+    static type& get(function_ref_target t)
+    {
+        return *static_cast<type*>(t.object);
+    }
+};
+
+template<class F>
+struct function_ref_access<F, typename std::enable_if<std::is_function<typename std::remove_pointer<typename std::decay<F>::type>::type>::value>::type>
+{
+    typedef typename std::decay<F>::type type;
+
+    static function_ref_target make(type f)
+    {
+        function_ref_target t;
+        t.function = reinterpret_cast<void (*)()>(f);
+        return t;
+    }
+
+    static type get(function_ref_target t)
+    {
+        return reinterpret_cast<type>(t.function);
+    }
+};
+
+}
+
+template<class Signature>
+class function_ref;
+
+template<class R, class... Ts>
+class function_ref<R(Ts...)>
+{
+    detail::function_ref_target target;
+    R (*callback)(detail::function_ref_target, Ts...);
+
+    template<class F>
+    static R invoke(detail::function_ref_target t, Ts... xs)
+    {
+        return static_cast<R>(fit::apply(detail::function_ref_access<F>::get(t), fit::forward<Ts>(xs)...));
+    }
+public:
+    template<class F, class=typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, function_ref>::value &&
+        is_callable<F&, Ts...>::value
+    >::type, class=typename std::enable_if<
+        detail::function_ref_returns<R, decltype(fit::apply(std::declval<F&>(), std::declval<Ts>()...))>::value
+    >::type>
+    function_ref(F&& f) : target(detail::function_ref_access<F>::make(f)), callback(&invoke<F>)
+    {}
+
+    R operator()(Ts... xs) const
+    {
+        return callback(target, fit::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,369 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    iterate.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_ITERATE_H
+#define FIT_GUARD_ITERATE_H
+
+/// iterate
+/// =======
+///
+/// Description
+/// -----------
+///
+/// The `iterate` function adaptor returns a lazy sequence of the states that
+/// `repeat` goes through, so `iterate(f)(x)` is the sequence `x`, `f(x)`,
+/// `f(f(x))`, and so on. Each state is only computed when it is first read,
+/// after the iterator is incremented, so `take(n)` applies the function
+/// `n-1` times, and nothing is allocated. The iterators are input iterators,
+/// so the sequence can be used in a range-for loop or with the standard
+/// algorithms.
+///
+/// The sequence is infinite, unless it is bounded. Calling `take(n)` on the
+/// sequence stops it after `n` states, and calling `take_while(p)` stops it at
+/// the first state for which the predicate is false. The bounds can be
+/// combined, and the sequence stops at the first bound that is reached.
+///
+/// The states have the type of the initial argument, so the result of the
+/// function must be convertible back to it. Each iterator holds its own
+/// state, and a pointer to the sequence, so the sequence must outlive its
+/// iterators.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     constexpr iterate_adaptor<F> iterate(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(*std::next(iterate(f)(x).begin(), n) == repeat(n)(f)(x));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct twice
+///     {
+///         int operator()(int x) const
+///         {
+///             return x * 2;
+///         }
+///     };
+///
+///     int sum = 0;
+///     for(int x: fit::iterate(twice())(1).take(4)) sum += x;
+///     assert(sum == 1 + 2 + 4 + 8);
+///
+
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/make.h>
+#include <fit/detail/static_const_var.h>
+#include <fit/always.h>
+#include <cstddef>
+#include <iterator>
+#include <new>
+
+namespace fit {
+
+namespace detail {
+
+// The bounds are given the iterator rather than the state, so the state is
+// only computed for the bounds that read it
+struct iterate_unbounded
+{
+    template<class T>
+    constexpr bool done(std::size_t, const T&) const
+    {
+        return false;
+    }
+};
+
+struct iterate_take
+{
+    std::size_t n;
+
+    template<class T>
+    constexpr bool done(std::size_t i, const T&) const
+    {
+        return i >= n;
+    }
+};
+
+template<class P>
+struct iterate_while
+{
+    P p;
+
+    template<class T>
+    constexpr bool done(std::size_t, const T& it) const
+    {
+        return !p(*it);
+    }
+};
+
+// The state of an iterator, which is left empty for the end iterator, so
+// taking the end of a sequence doesn't copy its state
+template<class State>
+class iterate_state
+{
+    union { State value; };
+    bool engaged;
+public:
+    iterate_state() : engaged(false)
+    {}
+
+    explicit iterate_state(const State& x) : engaged(true)
+    {
+        new (&value) State(x);
+    }
+
+    iterate_state(const iterate_state& rhs) : engaged(rhs.engaged)
+    {
+        if (engaged) new (&value) State(rhs.value);
+    }
+
+    iterate_state(iterate_state&& rhs) : engaged(rhs.engaged)
+    {
+        if (engaged) new (&value) State(fit::move(rhs.value));
+    }
+
+    iterate_state& operator=(const iterate_state& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->reset();
+            if (rhs.engaged) new (&value) State(rhs.value);
+            engaged = rhs.engaged;
+        }
+        return *this;
+    }
+
+    iterate_state& operator=(iterate_state&& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->reset();
+            if (rhs.engaged) new (&value) State(fit::move(rhs.value));
+            engaged = rhs.engaged;
+        }
+        return *this;
+    }
+
+    ~iterate_state()
+    {
+        this->reset();
+    }
+
+    void reset()
+    {
+        if (engaged) value.~State();
+        engaged = false;
+    }
+
+    bool empty() const
+    {
+        return !engaged;
+    }
+
+    State& get()
+    {
+        return value;
+    }
+};
+
+template<class Bound1, class Bound2>
+struct iterate_both
+{
+    Bound1 b1;
+    Bound2 b2;
+
+    template<class T>
+    constexpr bool done(std::size_t i, const T& x) const
+    {
+        return b1.done(i, x) || b2.done(i, x);
+    }
+};
+
+template<class Bound1, class Bound2>
+struct iterate_bound
+{
+    typedef iterate_both<Bound1, Bound2> type;
+
+    static constexpr type make(Bound1 b1, Bound2 b2)
+    {
+        return type{fit::move(b1), fit::move(b2)};
+    }
+};
+
+template<class Bound2>
+struct iterate_bound<iterate_unbounded, Bound2>
+{
+    typedef Bound2 type;
+
+    static constexpr type make(iterate_unbounded, Bound2 b2)
+    {
+        return b2;
+    }
+};
+
+}
+
+template<class F, class State, class Bound=detail::iterate_unbounded>
+struct iterate_range
+{
+    F f;
+    State first;
+    Bound bound;
+
+    constexpr iterate_range(F g, State x, Bound b)
+    : f(fit::move(g)), first(fit::move(x)), bound(fit::move(b))
+    {}
+
+    class iterator
+    {
+        const iterate_range* range;
+        mutable detail::iterate_state<State> state;
+        std::size_t index;
+        // Whether the function still has to be applied to the state
+        mutable bool stale;
+
+        bool done() const
+        {
+            return state.empty() || range->bound.done(index, *this);
+        }
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef State value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const State* pointer;
+        typedef const State& reference;
+
+        // The end iterator
+        explicit iterator(const iterate_range* r)
+        : range(r), state(), index(0), stale(false)
+        {}
+
+        iterator(const iterate_range* r, const State& x)
+        : range(r), state(x), index(0), stale(false)
+        {}
+
+        reference operator*() const
+        {
+            if (stale)
+            {
+                state.get() = range->f(fit::move(state.get()));
+                stale = false;
+            }
+            return state.get();
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        iterator& operator++()
+        {
+            // A step that was never read is applied now, so only the last
+            // step is deferred
+            **this;
+            stale = true;
+            ++index;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        // Iterators are equal when both are done, or when neither is done
+        // and they are at the same position
+        friend bool operator==(const iterator& x, const iterator& y)
+        {
+            bool xdone = x.done();
+            bool ydone = y.done();
+            return xdone == ydone && (xdone || x.index == y.index);
+        }
+
+        friend bool operator!=(const iterator& x, const iterator& y)
+        {
+            return !(x == y);
+        }
+    };
+
+    iterator begin() const
+    {
+        return iterator(this, first);
+    }
+
+    iterator end() const
+    {
+        return iterator(this);
+    }
+
+    template<class NewBound>
+    constexpr iterate_range<F, State, typename detail::iterate_bound<Bound, NewBound>::type>
+    bounded(NewBound b) const
+    {
+        return iterate_range<F, State, typename detail::iterate_bound<Bound, NewBound>::type>(
+            f, first, detail::iterate_bound<Bound, NewBound>::make(bound, fit::move(b))
+        );
+    }
+
+    constexpr iterate_range<F, State, typename detail::iterate_bound<Bound, detail::iterate_take>::type>
+    take(std::size_t n) const
+    {
+        return this->bounded(detail::iterate_take{n});
+    }
+
+    template<class P>
+    constexpr iterate_range<F, State, typename detail::iterate_bound<Bound, detail::iterate_while<P>>::type>
+    take_while(P p) const
+    {
+        return this->bounded(detail::iterate_while<P>{fit::move(p)});
+    }
+};
+
+template<class F>
+struct iterate_adaptor : detail::callable_base<F>
+{
+    typedef iterate_adaptor fit_rewritable1_tag;
+    FIT_INHERIT_CONSTRUCTOR(iterate_adaptor, detail::callable_base<F>);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class T, class State=typename std::decay<T>::type>
+    constexpr iterate_range<detail::callable_base<F>, State> operator()(T&& x) const
+    {
+        return iterate_range<detail::callable_base<F>, State>(
+            this->base_function(x), State(fit::forward<T>(x)), detail::iterate_unbounded()
+        );
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(iterate, detail::make<iterate_adaptor>);
+
+}
+
+#endif
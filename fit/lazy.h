@@ -106,11 +106,34 @@ struct ref_transformer
     FIT_SFINAE_RETURNS(always_ref(x.get()));
 };
 
+// Moves a bound argument into the call, which is used when the lazy
+// expression is an rvalue
+template<class T>
+struct rvalue_transformer
+{
+    T&& x;
+
+    constexpr rvalue_transformer(T&& x) : x(fit::forward<T>(x))
+    {}
+
+    template<class... Ts>
+    constexpr T&& operator()(Ts&&...) const
+    {
+        return fit::forward<T>(x);
+    }
+};
+
 struct id_transformer
 {
     template<class T>
     constexpr auto operator()(const T& x) const 
     FIT_SFINAE_RETURNS(always_ref(x));
+
+    template<class T, typename std::enable_if<(!std::is_lvalue_reference<T>::value), int>::type = 0>
+    constexpr rvalue_transformer<T> operator()(T&& x) const
+    {
+        return rvalue_transformer<T>(fit::forward<T>(x));
+    }
 };
 
 FIT_DECLARE_STATIC_VAR(pick_transformer, conditional_adaptor<placeholder_transformer, bind_transformer, ref_transformer, id_transformer>);
@@ -179,7 +202,7 @@ struct lazy_invoker
     FIT_RETURNS_CLASS(lazy_invoker);
 
     template<class... Ts>
-    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    constexpr auto operator()(Ts&&... xs) FIT_CONST_LVALUE_QUALIFIER FIT_RETURNS
     (
         FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(xs...))(
             fit::detail::make_lazy_unpack(
@@ -188,6 +211,21 @@ struct lazy_invoker
             )
         )
     );
+
+#if FIT_HAS_RVALUE_THIS
+    // The bound arguments are moved into the call when the invoker is an
+    // rvalue
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) && FIT_RETURNS
+    (
+        (FIT_RETURNS_C_CAST(Pack&&)(FIT_CONST_THIS->get_pack(xs...)))(
+            fit::detail::make_lazy_unpack(
+                FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->base_function(xs...)), 
+                pack_forward(fit::forward<Ts>(xs)...)
+            )
+        )
+    );
+#endif
 };
 
 template<class F, class Pack>
@@ -238,37 +276,37 @@ struct lazy_adaptor : detail::callable_base<F>
     FIT_RETURNS_CLASS(lazy_adaptor);
 
     template<class T, class... Ts>
-    constexpr auto operator()(T x, Ts... xs) const FIT_RETURNS
+    constexpr auto operator()(T x, Ts... xs) FIT_CONST_LVALUE_QUALIFIER FIT_RETURNS
     (
-        fit::detail::make_lazy_invoker(FIT_RETURNS_C_CAST(detail::callable_base<F>&&)(FIT_CONST_THIS->base_function(x, xs...)), 
+        fit::detail::make_lazy_invoker(FIT_CONST_LVALUE_CAST(detail::callable_base<F>)(FIT_CONST_THIS->base_function(x, xs...)), 
             pack(fit::move(x), fit::move(xs)...))
     );
 
     // Workaround for gcc 4.7
     template<class Unused=int>
-    constexpr detail::lazy_nullary_invoker<F> operator()() const
+    constexpr detail::lazy_nullary_invoker<F> operator()() FIT_CONST_LVALUE_QUALIFIER
     {
-        return fit::detail::make_lazy_nullary_invoker((detail::callable_base<F>&&)(
+        return fit::detail::make_lazy_nullary_invoker(FIT_CONST_LVALUE_CAST(detail::callable_base<F>)(
             this->base_function(Unused())
         ));
     }
 
-    // TODO: Overloads to use with ref qualifiers
-
-    // template<class... Ts>
-    // constexpr auto operator()(Ts... xs) const& FIT_RETURNS
-    // (
-    //     fit::detail::make_lazy_invoker(this->base_function(xs...), 
-    //         pack(fit::move(xs)...))
-    // );
-
-    // template<class... Ts>
-    // constexpr auto operator()(Ts... xs) && FIT_RETURNS
-    // (
-    //     fit::detail::make_lazy_invoker((F&&)this->base_function(xs...), 
-    //         pack(fit::move(xs)...))
-    // );
-    
+#if FIT_HAS_RVALUE_THIS
+    template<class T, class... Ts>
+    constexpr auto operator()(T x, Ts... xs) && FIT_RETURNS
+    (
+        fit::detail::make_lazy_invoker(FIT_RETURNS_C_CAST(detail::callable_base<F>&&)(FIT_CONST_THIS->base_function(x, xs...)), 
+            pack(fit::move(x), fit::move(xs)...))
+    );
+
+    template<class Unused=int>
+    constexpr detail::lazy_nullary_invoker<F> operator()() &&
+    {
+        return fit::detail::make_lazy_nullary_invoker((detail::callable_base<F>&&)(
+            this->base_function(Unused())
+        ));
+    }
+#endif
 };
 
 FIT_DECLARE_STATIC_VAR(lazy, detail::make<lazy_adaptor>);
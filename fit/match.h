@@ -66,41 +66,201 @@
 #include <fit/detail/delegate.h>
 #include <fit/detail/move.h>
 #include <fit/detail/make.h>
+#include <fit/detail/seq.h>
 #include <fit/detail/static_const_var.h>
 
+#ifndef FIT_HAS_VARIADIC_USING
+#if defined(__cpp_variadic_using) && __cpp_variadic_using >= 201611
+#define FIT_HAS_VARIADIC_USING 1
+#else
+#define FIT_HAS_VARIADIC_USING 0
+#endif
+#endif
+
 namespace fit {
 
-template<class...Fs> struct match_adaptor;
- 
-template<class F, class...Fs>
-struct match_adaptor<F, Fs...> : detail::callable_base<F>, match_adaptor<Fs...>
+namespace detail {
+
+struct match_args_tag
+{};
+
+// Holds a reference to each argument of the constructor, so every function
+// can pick its own argument by index
+template<int N, class T>
+struct match_arg
 {
-    typedef match_adaptor<Fs...> base;
-    typedef match_adaptor fit_rewritable_tag;
+    T&& value;
+};
 
-    struct failure
-    : failure_for<detail::callable_base<F>, Fs...>
-    {};
+template<class Seq, class... Ts>
+struct match_args_base;
+
+template<int... Ns, class... Ts>
+struct match_args_base<seq<Ns...>, Ts...> : match_arg<Ns, Ts>...
+{
+    constexpr match_args_base(Ts&&... xs) : match_arg<Ns, Ts>{fit::forward<Ts>(xs)}...
+    {}
+};
+
+template<class... Ts>
+struct match_args : match_args_base<typename gens<sizeof...(Ts)>::type, Ts...>
+{
+    typedef match_args_base<typename gens<sizeof...(Ts)>::type, Ts...> base;
+    static constexpr int size = sizeof...(Ts);
+
+    constexpr match_args(Ts&&... xs) : base(fit::forward<Ts>(xs)...)
+    {}
+};
+
+template<int N, class T>
+constexpr T&& match_arg_get(const match_arg<N, T>& x)
+{
+    return static_cast<T&&>(x.value);
+}
+
+// Every function is held in a leaf tagged by its index, so the same function
+// type can appear more than once. The functions that are not given to the
+// constructor are default constructed.
+template<int N, class F>
+struct match_leaf : detail::callable_base<F>
+{
+    FIT_INHERIT_DEFAULT(match_leaf, detail::callable_base<F>);
+
+    template<class Args, typename std::enable_if<(N < Args::size), int>::type = 0>
+    constexpr match_leaf(match_args_tag, const Args& args) : detail::callable_base<F>(match_arg_get<N>(args))
+    {}
+
+    template<class Args, typename std::enable_if<(N >= Args::size), int>::type = 0>
+    constexpr match_leaf(match_args_tag, const Args&) : detail::callable_base<F>()
+    {}
+
+    using detail::callable_base<F>::operator();
+};
+
+#if FIT_HAS_VARIADIC_USING
+
+template<class Seq, class... Fs>
+struct match_base;
+
+template<int... Ns, class... Fs>
+struct match_base<seq<Ns...>, Fs...> : match_leaf<Ns, Fs>...
+{
+    FIT_INHERIT_DEFAULT(match_base, detail::callable_base<Fs>...);
+
+    template<class Args>
+    constexpr match_base(match_args_tag, const Args& args) : match_leaf<Ns, Fs>(match_args_tag(), args)...
+    {}
+
+    using match_leaf<Ns, Fs>::operator()...;
+};
 
-    FIT_INHERIT_DEFAULT(match_adaptor, detail::callable_base<F>, base);
+template<class... Fs>
+struct match_storage
+{
+    typedef match_base<typename gens<sizeof...(Fs)>::type, Fs...> type;
+};
+
+#else
+
+// Without variadic using-declarations, every class can only bring in a fixed
+// number of overloads, so the leaves are inherited eight at a time, which
+// makes the chain of bases eight times shorter
+template<int Offset, class... Fs>
+struct match_chain;
+
+template<int Offset, class F, class... Fs>
+struct match_chain<Offset, F, Fs...> : match_leaf<Offset, F>, match_chain<Offset + 1, Fs...>
+{
+    typedef match_leaf<Offset, F> leaf;
+    typedef match_chain<Offset + 1, Fs...> base;
+
+    FIT_INHERIT_DEFAULT(match_chain, leaf, base);
 
-    template<class X, class... Xs, FIT_ENABLE_IF_CONVERTIBLE(X, detail::callable_base<F>), FIT_ENABLE_IF_CONSTRUCTIBLE(base, Xs...)>
-    constexpr match_adaptor(X&& f1, Xs&& ... fs) 
-    : detail::callable_base<F>(fit::forward<X>(f1)), base(fit::forward<Xs>(fs)...)
+    template<class Args>
+    constexpr match_chain(match_args_tag, const Args& args) : leaf(match_args_tag(), args), base(match_args_tag(), args)
     {}
 
-    using F::operator();
+    using leaf::operator();
     using base::operator();
 };
 
-template<class F>
-struct match_adaptor<F> : detail::callable_base<F>
+template<int Offset, class F0, class F1, class F2, class F3, class F4, class F5, class F6, class F7, class F8, class... Fs>
+struct match_chain<Offset, F0, F1, F2, F3, F4, F5, F6, F7, F8, Fs...> 
+: match_leaf<Offset, F0>, match_leaf<Offset + 1, F1>, match_leaf<Offset + 2, F2>, match_leaf<Offset + 3, F3>,
+  match_leaf<Offset + 4, F4>, match_leaf<Offset + 5, F5>, match_leaf<Offset + 6, F6>, match_leaf<Offset + 7, F7>,
+  match_chain<Offset + 8, F8, Fs...>
 {
-    typedef detail::callable_base<F> base;
+    typedef match_chain<Offset + 8, F8, Fs...> base;
+
+    FIT_INHERIT_DEFAULT(match_chain, 
+        match_leaf<Offset, F0>, match_leaf<Offset + 1, F1>, match_leaf<Offset + 2, F2>, match_leaf<Offset + 3, F3>,
+        match_leaf<Offset + 4, F4>, match_leaf<Offset + 5, F5>, match_leaf<Offset + 6, F6>, match_leaf<Offset + 7, F7>,
+        base);
+
+    template<class Args>
+    constexpr match_chain(match_args_tag, const Args& args) 
+    : match_leaf<Offset, F0>(match_args_tag(), args), match_leaf<Offset + 1, F1>(match_args_tag(), args),
+      match_leaf<Offset + 2, F2>(match_args_tag(), args), match_leaf<Offset + 3, F3>(match_args_tag(), args),
+      match_leaf<Offset + 4, F4>(match_args_tag(), args), match_leaf<Offset + 5, F5>(match_args_tag(), args),
+      match_leaf<Offset + 6, F6>(match_args_tag(), args), match_leaf<Offset + 7, F7>(match_args_tag(), args),
+      base(match_args_tag(), args)
+    {}
+
+    using match_leaf<Offset, F0>::operator();
+    using match_leaf<Offset + 1, F1>::operator();
+    using match_leaf<Offset + 2, F2>::operator();
+    using match_leaf<Offset + 3, F3>::operator();
+    using match_leaf<Offset + 4, F4>::operator();
+    using match_leaf<Offset + 5, F5>::operator();
+    using match_leaf<Offset + 6, F6>::operator();
+    using match_leaf<Offset + 7, F7>::operator();
+    using base::operator();
+};
+
+template<int Offset, class F>
+struct match_chain<Offset, F> : match_leaf<Offset, F>
+{
+    typedef match_leaf<Offset, F> base;
+    FIT_INHERIT_CONSTRUCTOR(match_chain, base);
+
+    using base::operator();
+};
+
+template<class... Fs>
+struct match_storage
+{
+    typedef match_chain<0, Fs...> type;
+};
+
+#endif
+
+template<class F, class... Fs>
+struct match_head
+{
+    typedef detail::callable_base<F> type;
+};
+
+}
+
+template<class... Fs>
+struct match_adaptor : detail::match_storage<Fs...>::type
+{
+    typedef typename detail::match_storage<Fs...>::type base;
     typedef match_adaptor fit_rewritable_tag;
-    using F::operator();
 
-    FIT_INHERIT_CONSTRUCTOR(match_adaptor, detail::callable_base<F>);
+    struct failure
+    : failure_for<detail::callable_base<Fs>...>
+    {};
+
+    FIT_INHERIT_DEFAULT(match_adaptor, detail::callable_base<Fs>...);
+
+    template<class X, class... Xs, typename std::enable_if<(sizeof...(Xs) < sizeof...(Fs)), int>::type = 0,
+        FIT_ENABLE_IF_CONVERTIBLE(X, typename detail::match_head<Fs...>::type)>
+    constexpr match_adaptor(X&& x, Xs&&... xs) 
+    : base(detail::match_args_tag(), detail::match_args<X, Xs...>(fit::forward<X>(x), fit::forward<Xs>(xs)...))
+    {}
+
+    using base::operator();
 };
 
 FIT_DECLARE_STATIC_VAR(match, detail::make<match_adaptor>);
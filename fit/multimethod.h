@@ -0,0 +1,405 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    multimethod.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_MULTIMETHOD_H
+#define FIT_GUARD_MULTIMETHOD_H
+
+/// multimethod
+/// ===========
+///
+/// Description
+/// -----------
+///
+/// The `multimethod` function adaptor chooses an overload by the dynamic
+/// types of its arguments, which are references or pointers to a
+/// polymorphic `Base` class. The parameters of the overloads are references
+/// or pointers to classes derived from `Base`, which are read from their
+/// signatures, so the overloads can't be generic. Of the overloads whose
+/// parameters match the dynamic types of the arguments, every one that is
+/// dominated by another, because each of its parameters is a base of the
+/// other one's parameter, is dropped, and the one that is left is called. So
+/// an overload that takes `Base` is only called when nothing else matches, and
+/// can be used as a fallback. The choice doesn't depend on the order of the
+/// overloads. If no overload matches, then `std::bad_cast` is thrown, and if
+/// more than one is left, then `fit::ambiguous_multimethod` is thrown, which
+/// is also a `std::bad_cast`.
+///
+/// The first call with some combination of dynamic types finds the overload
+/// with `dynamic_cast`, and keeps it in a cache keyed by the `type_info` of
+/// the arguments, along with how to adjust each argument. Every following
+/// call with the same types is a single lookup and a call, without any cast.
+/// Since the adjustment is keyed by the dynamic type only, `Base` must be an
+/// unambiguous base of every dynamic type, that is, it can't be repeated as a
+/// non-virtual base.
+///
+/// The cache is chosen by a policy, which is one of the policies of
+/// `fix_memo`. The default is `memo_flat_map`, which is not safe to call
+/// concurrently, so `memo_sharded` should be used for that. Copies of the
+/// adaptor share their cache. When `Base` is const, the overloads must take
+/// const references or pointers.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Base, class Policy=memo_flat_map, class... Fs>
+///     multimethod_adaptor<Base, Policy, Fs...> multimethod(Fs... fs);
+///
+/// Requirements
+/// ------------
+///
+/// Base must be:
+///
+/// * Polymorphic
+/// * An unambiguous base of the parameters, and of the dynamic types of the
+///   arguments
+///
+/// Fs must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+/// * Not generic
+///
+/// Example
+/// -------
+///
+///     struct shape { virtual ~shape() {} };
+///     struct circle : shape {};
+///     struct square : shape {};
+///
+///     auto collide = fit::multimethod<const shape>(
+///         [](const circle&, const circle&) { return 1; },
+///         [](const circle&, const square&) { return 2; },
+///         [](const shape&, const shape&) { return 0; }
+///     );
+///
+///     circle c;
+///     square s;
+///     const shape& x = c;
+///     const shape& y = s;
+///     assert(collide(x, y) == 2);
+///     assert(collide(y, x) == 0);
+///
+
+#include <fit/fix_memo.h>
+#include <fit/detail/and.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+
+namespace fit {
+
+// Thrown when more than one overload of a multimethod matches, and none of
+// them dominates the others
+struct ambiguous_multimethod : std::bad_cast
+{
+    const char* what() const noexcept override
+    {
+        return "fit::ambiguous_multimethod";
+    }
+};
+
+namespace detail {
+
+template<class... Ts>
+struct multimethod_params
+{
+    static const std::size_t size = sizeof...(Ts);
+};
+
+template<class F>
+struct multimethod_signature
+: multimethod_signature<decltype(&F::operator())>
+{};
+
+template<class R, class... Ts>
+struct multimethod_signature<R(*)(Ts...)>
+{
+    typedef multimethod_params<Ts...> type;
+};
+
+template<class R, class C, class... Ts>
+struct multimethod_signature<R(C::*)(Ts...)>
+{
+    typedef multimethod_params<Ts...> type;
+};
+
+template<class R, class C, class... Ts>
+struct multimethod_signature<R(C::*)(Ts...) const>
+{
+    typedef multimethod_params<Ts...> type;
+};
+
+// A parameter is a reference or a pointer to a class derived from Base,
+// which is reached by adding an offset to the address of the Base
+template<class Base, class P>
+struct multimethod_param;
+
+template<class Base, class D>
+struct multimethod_param_base
+{
+    typedef D object;
+    typedef typename std::remove_cv<D>::type type;
+    static_assert(std::is_base_of<typename std::remove_cv<Base>::type, type>::value,
+        "The parameters of a multimethod must be derived from the base");
+    static_assert(!std::is_const<Base>::value || std::is_const<D>::value,
+        "The parameters of a multimethod can't drop the qualifiers of the base");
+    // The offset of the base is cached for each dynamic type, which is only
+    // right when there is a single base in the object
+    static_assert(std::is_convertible<type*, typename std::remove_cv<Base>::type*>::value,
+        "The base of a multimethod must be an unambiguous public base of the parameters");
+
+    static D* cast(Base* p, std::ptrdiff_t offset)
+    {
+        typedef typename std::conditional<std::is_const<Base>::value, const char, char>::type byte;
+        return static_cast<D*>(static_cast<void*>(const_cast<char*>(reinterpret_cast<byte*>(p)) + offset));
+    }
+
+    // Returns false when the dynamic type isn't derived from the parameter
+    static bool offset(Base* p, std::ptrdiff_t& result)
+    {
+        D* d = dynamic_cast<D*>(p);
+        if (d == nullptr) return false;
+        result = reinterpret_cast<const volatile char*>(d) - reinterpret_cast<const volatile char*>(p);
+        return true;
+    }
+};
+
+template<class Base, class D>
+struct multimethod_param<Base, D&> : multimethod_param_base<Base, D>
+{
+    static D& get(Base* p, std::ptrdiff_t offset)
+    {
+        return *multimethod_param_base<Base, D>::cast(p, offset);
+    }
+};
+
+template<class Base, class D>
+struct multimethod_param<Base, D*> : multimethod_param_base<Base, D>
+{
+    static D* get(Base* p, std::ptrdiff_t offset)
+    {
+        return multimethod_param_base<Base, D>::cast(p, offset);
+    }
+};
+
+template<class Base, class Params>
+struct multimethod_overload;
+
+template<class Base, class... Ps>
+struct multimethod_overload<Base, multimethod_params<Ps...>>
+{
+    template<class R, class F, int... Ks>
+    static R call(const F& f, Base* const* ps, const std::ptrdiff_t* offsets, seq<Ks...>)
+    {
+        return f(multimethod_param<Base, Ps>::get(ps[Ks], offsets[Ks])...);
+    }
+
+    template<int... Ks>
+    static bool match(Base* const* ps, std::ptrdiff_t* offsets, seq<Ks...>)
+    {
+        bool result = true;
+        (void)std::initializer_list<int>{(result = result && multimethod_param<Base, Ps>::offset(ps[Ks], offsets[Ks]), 0)...};
+        return result;
+    }
+
+    template<class F>
+    struct result
+    {
+        typedef decltype(std::declval<const F&>()(std::declval<Ps>()...)) type;
+    };
+};
+
+// One overload dominates another when every parameter is derived from the
+// parameter of the other, so every overload dominates itself
+template<class Base, class P, class Q>
+struct multimethod_dominates;
+
+template<class Base, class... Ps, class... Qs>
+struct multimethod_dominates<Base, multimethod_params<Ps...>, multimethod_params<Qs...>>
+: and_<std::is_base_of<
+    typename multimethod_param<Base, Qs>::type,
+    typename multimethod_param<Base, Ps>::type
+>...>
+{};
+
+template<class Base, class Overloads, class Seq>
+struct multimethod_dominance;
+
+template<class Base, class... Params, int... Ns>
+struct multimethod_dominance<Base, std::tuple<Params...>, seq<Ns...>>
+{
+    static bool get(std::size_t i, std::size_t j)
+    {
+        static const bool table[] = { multimethod_dominates<Base,
+            typename std::tuple_element<Ns / sizeof...(Params), std::tuple<Params...>>::type,
+            typename std::tuple_element<Ns % sizeof...(Params), std::tuple<Params...>>::type
+        >::value... };
+        return table[i * sizeof...(Params) + j];
+    }
+};
+
+template<int N, class F>
+struct multimethod_leaf : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(multimethod_leaf, detail::callable_base<F>);
+};
+
+template<int N, class F>
+const detail::callable_base<F>& multimethod_get(const multimethod_leaf<N, F>& x)
+{
+    return x;
+}
+
+template<int N, class T>
+struct multimethod_key_element
+{
+    typedef T type;
+};
+
+template<class Seq>
+struct multimethod_key;
+
+template<int... Ns>
+struct multimethod_key<seq<Ns...>>
+{
+    typedef std::tuple<typename multimethod_key_element<Ns, const std::type_info*>::type...> type;
+};
+
+template<class Base, class Seq, class... Fs>
+struct multimethod_base;
+
+template<class Base, int... Is, class... Fs>
+struct multimethod_base<Base, seq<Is...>, Fs...> : multimethod_leaf<Is, Fs>...
+{
+    typedef typename std::tuple_element<0, std::tuple<typename multimethod_signature<Fs>::type...>>::type first_params;
+    static const std::size_t arity = first_params::size;
+    static const std::size_t size = sizeof...(Fs);
+    typedef typename gens<arity>::type arity_seq;
+
+    static_assert(std::is_polymorphic<Base>::value, "The base of a multimethod must be polymorphic");
+    static_assert(and_<std::integral_constant<bool, (multimethod_signature<Fs>::type::size == arity)>...>::value,
+        "The overloads of a multimethod must all take the same number of parameters");
+
+    typedef typename std::common_type<
+        typename multimethod_overload<Base, typename multimethod_signature<Fs>::type>::template result<detail::callable_base<Fs>>::type...
+    >::type result_type;
+
+    // What the cache keeps for each combination of dynamic types
+    struct entry
+    {
+        result_type (*call)(const multimethod_base&, Base* const*, const std::ptrdiff_t*);
+        std::array<std::ptrdiff_t, arity> offsets;
+    };
+
+    multimethod_base(Fs... fs) : multimethod_leaf<Is, Fs>(fit::move(fs))...
+    {}
+
+    template<int I>
+    static result_type invoke(const multimethod_base& self, Base* const* ps, const std::ptrdiff_t* offsets)
+    {
+        typedef typename std::tuple_element<I, std::tuple<Fs...>>::type f;
+        return multimethod_overload<Base, typename multimethod_signature<f>::type>::template call<result_type>(
+            multimethod_get<I>(self), ps, offsets, arity_seq());
+    }
+
+    static bool dominates(std::size_t i, std::size_t j)
+    {
+        return multimethod_dominance<Base,
+            std::tuple<typename multimethod_signature<Fs>::type...>,
+            typename gens<sizeof...(Fs) * sizeof...(Fs)>::type
+        >::get(i, j);
+    }
+
+    static bool strictly_dominates(std::size_t i, std::size_t j)
+    {
+        return dominates(i, j) && !dominates(j, i);
+    }
+
+    // Drops every overload that matches but is dominated by another one that
+    // matches, and there must be exactly one left
+    static entry resolve(Base* const* ps)
+    {
+        typedef result_type (*entry_type)(const multimethod_base&, Base* const*, const std::ptrdiff_t*);
+        static constexpr entry_type calls[] = { &invoke<Is>... };
+        std::ptrdiff_t offsets[size][arity ? arity : 1] = {};
+        const bool viable[] = {
+            multimethod_overload<Base, typename multimethod_signature<Fs>::type>::match(ps, offsets[Is], arity_seq())...
+        };
+        std::size_t best = size;
+        for(std::size_t i = 0; i < size; i++)
+        {
+            if (!viable[i]) continue;
+            bool dominated = false;
+            for(std::size_t j = 0; j < size && !dominated; j++) dominated = viable[j] && strictly_dominates(j, i);
+            if (dominated) continue;
+            if (best != size) throw ambiguous_multimethod();
+            best = i;
+        }
+        if (best == size) throw std::bad_cast();
+        entry result = { calls[best], {} };
+        for(std::size_t k = 0; k < arity; k++) result.offsets[k] = offsets[best][k];
+        return result;
+    }
+};
+
+template<class Base>
+Base* multimethod_pointer(Base& x)
+{
+    return &x;
+}
+
+template<class Base>
+Base* multimethod_pointer(Base* x)
+{
+    return x;
+}
+
+}
+
+template<class Base, class Policy, class... Fs>
+struct multimethod_adaptor
+: detail::multimethod_base<Base, typename detail::gens<sizeof...(Fs)>::type, Fs...>
+{
+    typedef detail::multimethod_base<Base, typename detail::gens<sizeof...(Fs)>::type, Fs...> base;
+    typedef typename detail::multimethod_key<typename base::arity_seq>::type key_type;
+    typedef typename Policy::template apply<key_type, typename base::entry>::type cache_type;
+    typedef typename base::result_type result_type;
+
+    std::shared_ptr<cache_type> cache;
+
+    multimethod_adaptor(Fs... fs) : base(fit::move(fs)...), cache(std::make_shared<cache_type>())
+    {}
+
+    template<class... Ts, class=typename std::enable_if<(sizeof...(Ts) == base::arity)>::type>
+    result_type operator()(Ts&&... xs) const
+    {
+        Base* const ps[] = { detail::multimethod_pointer<Base>(xs)..., nullptr };
+        typename base::entry e = cache->get(key_type(&typeid(*detail::multimethod_pointer<Base>(xs))...), [&]
+        {
+            return base::resolve(ps);
+        });
+        return e.call(*this, ps, e.offsets.data());
+    }
+};
+
+template<class Base, class Policy=memo_flat_map, class... Fs>
+multimethod_adaptor<Base, Policy, Fs...> multimethod(Fs... fs)
+{
+    return multimethod_adaptor<Base, Policy, Fs...>(fit::move(fs)...);
+}
+
+}
+
+#endif
@@ -57,6 +57,7 @@
 
 #include <fit/detail/seq.h>
 #include <fit/detail/delegate.h>
+#include <fit/detail/is_final.h>
 #include <fit/detail/remove_rvalue_reference.h>
 #include <fit/detail/unwrap.h>
 #include <fit/detail/static_const_var.h>
@@ -64,12 +65,8 @@
 #include <fit/alias.h>
 #include <fit/decay.h>
 
-#ifndef FIT_HAS_RVALUE_THIS
-#define FIT_HAS_RVALUE_THIS 1
-#endif
-
 #ifndef FIT_PACK_HAS_EBO
-#ifdef __clang__
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 7)
 #define FIT_PACK_HAS_EBO 1
 #else
 #define FIT_PACK_HAS_EBO 0
@@ -78,41 +75,142 @@
 
 namespace fit { namespace detail {
 
-template<class...>
+// The tag for each element only carries its index, so the type of each
+// holder(and its mangled name) stays the same size no matter how many
+// elements are in the pack.
+template<int N>
 struct pack_tag
 {};
 
+template<class Seq, class... Ts>
+struct pack_base;
+
+// Empty types that can be default constructed at compile time take no
+// storage at all, which avoids giving the same empty base class twice
+template<class T>
+struct pack_holder_is_static
+: std::integral_constant<bool, 
+    std::is_empty<T>::value && 
+    std::is_literal_type<T>::value && 
+    is_default_constructible<T>::value
+>
+{};
+
+template<class Seq, class... Ts>
+std::true_type is_pack_derived_check(const volatile pack_base<Seq, Ts...>*);
+
+std::false_type is_pack_derived_check(...);
+
+template<class T>
+struct is_pack_derived
+: decltype(is_pack_derived_check(static_cast<T*>(nullptr)))
+{};
+
+// Since the tags are only indices, a type that carries its own pack can't be
+// inherited, or else its holders would clash with the holders of the pack
+// that contains it. A final type can't be inherited either. An empty type
+// that appears more than once still takes a byte for each repeat, since
+// objects of the same type need distinct addresses.
+template<class T, bool Empty=std::is_empty<T>::value>
+struct pack_holder_is_inherited
+: std::false_type
+{};
+
+template<class T>
+struct pack_holder_is_inherited<T, true>
+: std::integral_constant<bool, !is_pack_derived<T>::value && !is_final<T>::value>
+{};
+
 #if FIT_PACK_HAS_EBO
 template<class T, class Tag>
 struct pack_holder
-: std::conditional<std::is_empty<T>::value, 
-    alias_inherit<T, Tag>, 
-    alias<T, Tag>
+: std::conditional<pack_holder_is_static<T>::value,
+    alias_static<T, Tag>,
+    typename std::conditional<pack_holder_is_inherited<T>::value, 
+        alias_inherit<T, Tag>, 
+        alias<T, Tag>
+    >::type
 >
 {};
 #else
 template<class T, class Tag>
 struct pack_holder
-: std::conditional<
-        std::is_empty<T>::value && 
-        std::is_literal_type<T>::value && 
-        is_default_constructible<T>::value,
+: std::conditional<pack_holder_is_static<T>::value,
     alias_static<T, Tag>,
     alias<T, Tag>
 >
 {};
 #endif
 
-template<class Seq, class... Ts>
-struct pack_base;
+// The holder for the Nth element of type T
+template<int N, class T>
+struct pack_leaf
+: pack_holder<T, pack_tag<N>>
+{};
+
+template<class P, class T>
+struct pack_leaf_ref
+{
+    typedef T&& type;
+};
+
+template<class P, class T>
+struct pack_leaf_ref<P&, T>
+{
+    typedef T& type;
+};
+
+template<class P, class T>
+struct pack_leaf_ref<const P&, T>
+{
+    typedef const T& type;
+};
+
+// Casts the pack directly to the holder of the Nth element, rather than
+// searching through all the bases of the pack for the matching tag
+template<int N, class T, class P>
+constexpr typename pack_leaf_ref<P&&, typename pack_leaf<N, T>::type>::type 
+pack_leaf_cast(P&& p)
+{
+    return static_cast<typename pack_leaf_ref<P&&, typename pack_leaf<N, T>::type>::type>(p);
+}
+
+template<int N, class T, class P, class... Xs>
+constexpr auto pack_value(P&& p, Xs&&... xs) FIT_RETURNS
+(
+    alias_value<pack_tag<N>, T>(pack_leaf_cast<N, T>(fit::forward<P>(p)), xs...)
+);
 
-template<class T, class Tag, class X, class... Ts>
-constexpr T&& pack_get(X&& x, Ts&&... xs)
+template<int N, class T, class P, class... Xs>
+constexpr T&& pack_get(P&& p, Xs&&... xs)
 {
     // C style cast(rather than static_cast) is needed for gcc
-    return (T&&)(alias_value<Tag, T>(x, xs...));
+    return (T&&)(pack_value<N, T>(p, xs...));
+}
+
+// Gets the Nth element of a pack of references(such as the one made by
+// pack_forward) without naming its type, since references are always held
+// in an alias that can be deduced by its tag
+template<int N, class T>
+constexpr T&& pack_ref(const alias<T, pack_tag<N>>& x)
+{
+    return (T&&)(x.value);
+}
+
+// References are passed along as they are, whereas values are moved out of
+// an rvalue pack and are passed as lvalues otherwise
+template<int N, class T, class P, class... Xs, typename std::enable_if<(std::is_reference<T>::value), int>::type = 0>
+constexpr T&& pack_forward_value(P&& p, Xs&&... xs)
+{
+    return pack_get<N, T>(p, xs...);
 }
 
+template<int N, class T, class P, class... Xs, typename std::enable_if<(!std::is_reference<T>::value), int>::type = 0>
+constexpr auto pack_forward_value(P&& p, Xs&&... xs) FIT_RETURNS
+(
+    pack_value<N, T>(fit::forward<P>(p), xs...)
+);
+
 #if (defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7) || defined(_MSC_VER)
 template<class... Ts>
 struct pack_holder_base
@@ -136,20 +234,11 @@ struct pack_holder_base<T>
     FIT_INHERIT_CONSTRUCTOR(pack_holder_base, base);
 };
 
-template<class... Ts>
-struct pack_holder_builder
-{
-    template<class T, int N>
-    struct apply
-    : pack_holder<T, pack_tag<seq<N>, Ts...>>
-    {};
-};
-
 template<int... Ns, class... Ts>
 struct pack_base<seq<Ns...>, Ts...>
-: pack_holder_base<typename pack_holder_builder<Ts...>::template apply<Ts, Ns>...>
+: pack_holder_base<pack_leaf<Ns, Ts>...>
 {
-    typedef pack_holder_base<typename pack_holder_builder<Ts...>::template apply<Ts, Ns>...> base;
+    typedef pack_holder_base<pack_leaf<Ns, Ts>...> base;
     template<class X1, class X2, class... Xs>
     constexpr pack_base(X1&& x1, X2&& x2, Xs&&... xs) 
     : base(fit::forward<X1>(x1), fit::forward<X2>(x2), fit::forward<Xs>(xs)...)
@@ -166,10 +255,18 @@ struct pack_base<seq<Ns...>, Ts...>
     FIT_RETURNS_CLASS(pack_base);
   
     template<class F>
-    constexpr auto operator()(F&& f) const FIT_RETURNS
+    constexpr auto operator()(F&& f) FIT_CONST_LVALUE_QUALIFIER FIT_RETURNS
+    (
+        f(pack_forward_value<Ns, Ts>(FIT_CONST_LVALUE_CAST(pack_base)(*FIT_CONST_THIS), f)...)
+    );
+
+#if FIT_HAS_RVALUE_THIS
+    template<class F>
+    constexpr auto operator()(F&& f) && FIT_RETURNS
     (
-        f(pack_get<Ts, pack_tag<seq<Ns>, Ts...>>(*FIT_CONST_THIS, f)...)
+        f(pack_forward_value<Ns, Ts>(FIT_RETURNS_C_CAST(pack_base&&)(*FIT_CONST_THIS), f)...)
     );
+#endif
 
     template<class F>
     struct apply
@@ -179,9 +276,9 @@ struct pack_base<seq<Ns...>, Ts...>
 
 template<class T>
 struct pack_base<seq<0>, T>
-: pack_holder_base<pack_holder<T, pack_tag<seq<0>, T>>>
+: pack_holder_base<pack_leaf<0, T>>
 {
-    typedef pack_holder_base<pack_holder<T, pack_tag<seq<0>, T>>> base;
+    typedef pack_holder_base<pack_leaf<0, T>> base;
 
     template<class X1, typename std::enable_if<(std::is_constructible<base, X1>::value), int>::type = 0>
     constexpr pack_base(X1&& x1) 
@@ -193,10 +290,18 @@ struct pack_base<seq<0>, T>
     FIT_RETURNS_CLASS(pack_base);
   
     template<class F>
-    constexpr auto operator()(F&& f) const FIT_RETURNS
+    constexpr auto operator()(F&& f) FIT_CONST_LVALUE_QUALIFIER FIT_RETURNS
+    (
+        f(pack_forward_value<0, T>(FIT_CONST_LVALUE_CAST(pack_base)(*FIT_CONST_THIS), f))
+    );
+
+#if FIT_HAS_RVALUE_THIS
+    template<class F>
+    constexpr auto operator()(F&& f) && FIT_RETURNS
     (
-        f(pack_get<T, pack_tag<seq<0>, T>>(*FIT_CONST_THIS, f))
+        f(pack_forward_value<0, T>(FIT_RETURNS_C_CAST(pack_base&&)(*FIT_CONST_THIS), f))
     );
+#endif
 
     template<class F>
     struct apply
@@ -208,21 +313,31 @@ struct pack_base<seq<0>, T>
 
 template<int... Ns, class... Ts>
 struct pack_base<seq<Ns...>, Ts...>
-: pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type...
+: pack_leaf<Ns, Ts>::type...
 {
     // FIT_INHERIT_DEFAULT(pack_base, typename std::remove_cv<typename std::remove_reference<Ts>::type>::type...);
     FIT_INHERIT_DEFAULT(pack_base, Ts...);
     
-    template<class... Xs, FIT_ENABLE_IF_CONVERTIBLE_UNPACK(Xs&&, typename pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type)>
-    constexpr pack_base(Xs&&... xs) : pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type(fit::forward<Xs>(xs))...
+    template<class... Xs, FIT_ENABLE_IF_CONVERTIBLE_UNPACK(Xs&&, typename pack_leaf<Ns, Ts>::type)>
+    constexpr pack_base(Xs&&... xs) : pack_leaf<Ns, Ts>::type(fit::forward<Xs>(xs))...
     {}
   
+    // Calling an lvalue pack passes its values as const lvalues, whereas
+    // calling an rvalue pack moves them. Without ref qualifiers, both move.
     template<class F>
-    constexpr auto operator()(F&& f) const FIT_RETURNS
+    constexpr auto operator()(F&& f) FIT_CONST_LVALUE_QUALIFIER FIT_RETURNS
     (
-        f(pack_get<Ts, pack_tag<seq<Ns>, Ts...>>(*this, f)...)
+        f(pack_forward_value<Ns, Ts>(FIT_CONST_LVALUE_CAST(pack_base)(*this), f)...)
     );
 
+#if FIT_HAS_RVALUE_THIS
+    template<class F>
+    constexpr auto operator()(F&& f) && FIT_RETURNS
+    (
+        f(pack_forward_value<Ns, Ts>(fit::move(*this), f)...)
+    );
+#endif
+
     template<class F>
     struct apply
     : F::template apply<Ts...>
@@ -247,38 +362,9 @@ struct pack_base<seq<> >
 #define FIT_DETAIL_UNPACK_PACK_BASE(ref, move) \
 template<class F, int... Ns, class... Ts> \
 constexpr auto unpack_pack_base(F&& f, pack_base<seq<Ns...>, Ts...> ref x) \
-FIT_RETURNS(f(alias_value<pack_tag<seq<Ns>, Ts...>, Ts>(move(x), f)...))
+FIT_RETURNS(f(pack_value<Ns, Ts>(move(x), f)...))
 FIT_UNARY_PERFECT_FOREACH(FIT_DETAIL_UNPACK_PACK_BASE)
 
-template<class P1, class P2>
-struct pack_join_base;
-
-// TODO: Extend to join more than two packs at a time
-template<int... Ns1, class... Ts1, int... Ns2, class... Ts2>
-struct pack_join_base<pack_base<seq<Ns1...>, Ts1...>, pack_base<seq<Ns2...>, Ts2...>>
-{
-    static constexpr long total_size = sizeof...(Ts1) + sizeof...(Ts2);
-    typedef pack_base<typename detail::gens<total_size>::type, Ts1..., Ts2...> result_type;
-
-    template<class P1, class P2>
-    static constexpr result_type call(P1&& p1, P2&& p2)
-    {
-        // TODO: static_assert that the pack is an rvalue if its only moveable
-        return result_type(
-            pack_get<Ts1, pack_tag<seq<Ns1>, Ts1...>>(fit::forward<P1>(p1))..., 
-            pack_get<Ts2, pack_tag<seq<Ns2>, Ts2...>>(fit::forward<P2>(p2))...);
-    }
-};
-
-template<class P1, class P2>
-struct pack_join_result 
-: pack_join_base<
-    typename std::remove_cv<typename std::remove_reference<P1>::type>::type, 
-    typename std::remove_cv<typename std::remove_reference<P2>::type>::type
->
-{};
-
-
 struct pack_f
 {
     template<class... Ts>
@@ -306,38 +392,123 @@ struct pack_decay_f
     );
 };
 
-template<class P1, class P2>
-constexpr typename pack_join_result<P1, P2>::result_type make_pack_join_dual(P1&& p1, P2&& p2)
+// Looks up the Nth of a list of types by deducing it from the base class
+// with that index, rather than by recursion
+template<int N, class T>
+struct pack_join_type
 {
-    return pack_join_result<P1, P2>::call(fit::forward<P1>(p1), fit::forward<P2>(p2));
-}
+    typedef T type;
+};
 
-// Manually compute join return type to make older gcc happy
-template<class... Ts>
-struct join_type;
+template<int N, class T>
+pack_join_type<N, T> pack_join_type_at(const pack_join_type<N, T>&);
 
-template<class T>
-struct join_type<T>
+template<class Seq, class... Ts>
+struct pack_join_types;
+
+template<int... Ns, class... Ts>
+struct pack_join_types<seq<Ns...>, Ts...>
+: pack_join_type<Ns, Ts>...
 {
-    typedef T type;
+    static constexpr int size = sizeof...(Ts);
 };
 
-template<class T, class... Ts>
-struct join_type<T, Ts...>
+template<class Types, int N>
+struct pack_join_type_of
+: decltype(pack_join_type_at<N>(std::declval<const Types&>()))
+{};
+
+template<class P, class Pack=typename std::remove_cv<typename std::remove_reference<P>::type>::type>
+struct pack_join_pack_types;
+
+template<class P, int... Ns, class... Ts>
+struct pack_join_pack_types<P, pack_base<seq<Ns...>, Ts...>>
+: pack_join_types<seq<Ns...>, Ts...>
+{};
+
+// Maps an index into the joined pack to the pack it comes from, and to its
+// index in that pack, from the sizes of the packs
+template<int... Sizes>
+struct pack_join_index
 {
-    typedef typename pack_join_result<T, typename join_type<Ts...>::type>::result_type type;
+    static constexpr int sizes[] = { Sizes..., 0 };
+    static constexpr int size = sizeof...(Sizes);
+
+    static constexpr int pack(int i, int j=0)
+    {
+        return j == size || i < sizes[j] ? j : pack(i - sizes[j], j + 1);
+    }
+
+    static constexpr int element(int i, int j=0)
+    {
+        return j == size || i < sizes[j] ? i : element(i - sizes[j], j + 1);
+    }
+
+    static constexpr int total(int j=0)
+    {
+        return j == size ? 0 : sizes[j] + total(j + 1);
+    }
 };
 
-template<class P1>
-constexpr P1 make_pack_join(P1&& p1)
+template<int... Sizes>
+constexpr int pack_join_index<Sizes...>::sizes[];
+
+// The Nth element of the Jth pack that is being joined, where P is how the
+// pack was passed in
+template<int J, int N, class P>
+struct pack_join_element
 {
-    return fit::forward<P1>(p1);
-}
+    typedef typename pack_join_type_of<pack_join_pack_types<P>, N>::type type;
+
+    template<class Packs>
+    static constexpr auto get(Packs& packs) FIT_RETURNS
+    (
+        pack_forward_value<N, type>(pack_get<J, P>(packs))
+    );
+};
+
+template<class... Elements>
+struct pack_join_elements
+{
+    typedef pack_base<typename gens<sizeof...(Elements)>::type, typename Elements::type...> result_type;
+
+    template<class Packs>
+    static constexpr result_type call(Packs&& packs)
+    {
+        return result_type(Elements::get(packs)...);
+    }
+};
+
+template<class Index, class Packs, int I, int J=Index::pack(I)>
+struct pack_join_element_at
+: pack_join_element<J, Index::element(I), typename pack_join_type_of<Packs, J>::type>
+{};
+
+// All of the (pack, element) pairs are computed from the sizes of the packs
+// in a single expansion, so no intermediate lists are built
+template<class Index, class Packs, class Seq=typename gens<Index::total()>::type>
+struct pack_join_base;
+
+template<class Index, class Packs, int... Is>
+struct pack_join_base<Index, Packs, seq<Is...>>
+: pack_join_elements<pack_join_element_at<Index, Packs, Is>...>
+{};
+
+template<class... Ps>
+struct pack_join_result
+: pack_join_base<
+    pack_join_index<pack_join_pack_types<Ps&&>::size...>,
+    pack_join_types<typename gens<sizeof...(Ps)>::type, Ps&&...>
+>
+{};
 
-template<class P1, class... Ps>
-constexpr typename join_type<P1, Ps...>::type make_pack_join(P1&& p1, Ps&&... ps)
+// All of the packs are joined at once: each element of the result is taken
+// directly from the pack it is in, by the index of the pack and its index
+// in that pack.
+template<class... Ps>
+constexpr typename pack_join_result<Ps...>::result_type make_pack_join(Ps&&... ps)
 {
-    return make_pack_join_dual(fit::forward<P1>(p1), make_pack_join(fit::forward<Ps>(ps)...));
+    return pack_join_result<Ps...>::call(pack_forward_f()(fit::forward<Ps>(ps)...));
 }
 
 struct pack_join_f
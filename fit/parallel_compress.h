@@ -0,0 +1,266 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    parallel_compress.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PARALLEL_COMPRESS_H
+#define FIT_GUARD_PARALLEL_COMPRESS_H
+
+/// parallel_compress
+/// =================
+///
+/// Description
+/// -----------
+///
+/// The `parallel_compress` function adaptor folds a runtime range with a
+/// binary function, like `compress` does for the arguments of a function. The
+/// range is split into chunks, which are folded on separate threads, and then
+/// the partial results are combined with the same binary function. It can be
+/// called with a pair of iterators or with a range, which is anything that
+/// works with `std::begin` and `std::end`.
+///
+/// The first chunk is folded starting with the initial state, and every other
+/// chunk is folded starting with its first element converted to the state,
+/// so that element is never passed to the function. So the binary function
+/// must be associative, and it must be callable with two states, as it is
+/// used to combine the partial results. Also, converting an element to the
+/// state must give the same state as folding it into an empty one, so a
+/// function that transforms the elements, such as a sum of squares, can't be
+/// used.
+///
+/// By default the partial results are combined in the order the chunks finish,
+/// so the function must also be commutative. When the `parallel_policy` is
+/// `ordered()`, the partial results are always combined from left to right
+/// instead, so the result is the same as the sequential fold. The number of
+/// threads defaults to `std::thread::hardware_concurrency()`, and no more
+/// threads than elements are used. The calling thread folds the first chunk
+/// itself. If the function throws, the exception is rethrown by the call,
+/// after every thread has finished.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F, class State>
+///     constexpr parallel_compress_adaptor<F, State> parallel_compress(F f, State s);
+///
+/// Semantics
+/// ---------
+///
+///     assert(parallel_compress(f, z)(first, last, parallel_policy(n).ordered()) ==
+///         std::accumulate(first, last, z, f));
+///
+/// Requirements
+/// ------------
+///
+/// State must be:
+///
+/// * MoveConstructible
+/// * Constructible from the elements of the range, where `State(x)` is the
+///   same as folding `x` with the identity of `F`
+///
+/// Iterator must be:
+///
+/// * ForwardIterator
+///
+/// F must be:
+///
+/// * [BinaryCallable](concepts.md#binarycallable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct sum_f
+///     {
+///         template<class T, class U>
+///         T operator()(T x, U y) const
+///         {
+///             return x + y;
+///         }
+///     };
+///     std::vector<int> v = {1, 2, 3, 4, 5};
+///     assert(fit::parallel_compress(sum_f(), 0)(v) == 15);
+///     assert(fit::parallel_compress(sum_f(), 0)(v.begin(), v.end(), fit::parallel_policy(2)) == 15);
+///
+
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/compressed_pair.h>
+#include <fit/detail/move.h>
+#include <fit/detail/make.h>
+#include <fit/detail/static_const_var.h>
+#include <condition_variable>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace fit {
+
+struct parallel_policy
+{
+    std::size_t threads;
+    bool in_order;
+
+    explicit constexpr parallel_policy(std::size_t n=0, bool o=false) : threads(n), in_order(o)
+    {}
+
+    // Combine the partial results from left to right
+    constexpr parallel_policy ordered() const
+    {
+        return parallel_policy(threads, true);
+    }
+};
+
+namespace detail {
+
+template<class State, class F, class Iterator>
+State parallel_fold(const F& f, State state, Iterator first, Iterator last)
+{
+    for(;first != last;++first) state = f(fit::move(state), *first);
+    return state;
+}
+
+// Folds every chunk but the first on its own thread, and joins the threads
+// even when the calling thread throws
+template<class State>
+struct parallel_chunks
+{
+    std::vector<std::future<State>> partials;
+    std::vector<std::thread> threads;
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<std::size_t> done;
+
+    ~parallel_chunks()
+    {
+        for(auto& t:threads) t.join();
+    }
+
+    // Starts a thread for every chunk but the first, which is returned as a
+    // task as well, so it can be run on the calling thread
+    template<class F, class Iterator>
+    std::packaged_task<State()> launch(const F& f, State& state, Iterator first, std::size_t n, std::size_t count)
+    {
+        std::size_t chunk = n / count;
+        std::size_t extra = n % count;
+        Iterator last_chunk = first;
+        std::advance(last_chunk, chunk + (extra > 0 ? 1 : 0));
+        partials.reserve(count);
+        threads.reserve(count - 1);
+        Iterator it = last_chunk;
+        for(std::size_t i = 1; i < count; i++)
+        {
+            Iterator start = it;
+            std::advance(it, chunk + (i < extra ? 1 : 0));
+            std::packaged_task<State()> task([&f, start, it]
+            {
+                Iterator next = start;
+                return parallel_fold(f, State(*start), ++next, it);
+            });
+            partials.push_back(task.get_future());
+            threads.emplace_back([this, i](std::packaged_task<State()> t)
+            {
+                t();
+                std::lock_guard<std::mutex> lock(m);
+                done.push_back(i);
+                cv.notify_one();
+            }, fit::move(task));
+        }
+        std::packaged_task<State()> task([&f, &state, first, last_chunk]
+        {
+            return parallel_fold(f, fit::move(state), first, last_chunk);
+        });
+        partials.insert(partials.begin(), task.get_future());
+        return task;
+    }
+
+    std::size_t next_done()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return !done.empty(); });
+        std::size_t i = done.back();
+        done.pop_back();
+        return i;
+    }
+
+    template<class F>
+    State combine(const F& f, bool in_order)
+    {
+        State result = partials.front().get();
+        for(std::size_t i = 1; i < partials.size(); i++)
+        {
+            std::size_t next = in_order ? i : next_done();
+            result = f(fit::move(result), partials[next].get());
+        }
+        return result;
+    }
+};
+
+// The result is written to the state, rather than returned, otherwise the
+// compiler tends to keep the state of the sequential fold on the stack as well
+template<class State, class F, class Iterator>
+void parallel_compress_chunks(const F& f, State& state, Iterator first, std::size_t n, parallel_policy p)
+{
+    parallel_chunks<State> chunks;
+    chunks.launch(f, state, first, n, p.threads)();
+    state = chunks.combine(f, p.in_order);
+}
+
+template<class State, class F, class Iterator>
+State parallel_compress_range(const F& f, State state, Iterator first, Iterator last, parallel_policy p)
+{
+    static_assert(std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>::value,
+        "The range of parallel_compress must have forward iterators, since it is split into chunks before it is folded");
+    std::size_t n = std::distance(first, last);
+    if (p.threads == 0) p.threads = std::thread::hardware_concurrency();
+    if (p.threads > n) p.threads = n;
+    if (p.threads < 2) return parallel_fold(f, fit::move(state), first, last);
+    parallel_compress_chunks(f, state, first, n, p);
+    return state;
+}
+
+}
+
+template<class F, class State>
+struct parallel_compress_adaptor
+: detail::compressed_pair<detail::callable_base<F>, State>
+{
+    typedef detail::compressed_pair<detail::callable_base<F>, State> base_type;
+    FIT_INHERIT_CONSTRUCTOR(parallel_compress_adaptor, base_type)
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr State get_state(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class Iterator>
+    State operator()(Iterator first, Iterator last, parallel_policy p=parallel_policy()) const
+    {
+        return detail::parallel_compress_range(this->base_function(first), this->get_state(first), first, last, p);
+    }
+
+    template<class Range>
+    State operator()(Range&& r, parallel_policy p=parallel_policy()) const
+    {
+        return (*this)(std::begin(r), std::end(r), p);
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(parallel_compress, detail::make<parallel_compress_adaptor>);
+
+}
+
+#endif
@@ -99,7 +99,7 @@ struct partial_adaptor_invoke
         >::type,
         id_<F&&>
     ) 
-    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    operator()(Ts&&... xs) FIT_CONST_LVALUE_QUALIFIER FIT_SFINAE_RETURNS
     (
         fit::pack_join
         (
@@ -108,6 +108,28 @@ struct partial_adaptor_invoke
         )
         (FIT_RETURNS_C_CAST(F&&)(FIT_CONST_THIS->get_function(xs...)))
     );
+
+#if FIT_HAS_RVALUE_THIS
+    // The partially applied arguments are moved when the adaptor is an rvalue
+    template<class... Ts>
+    constexpr FIT_SFINAE_RESULT
+    (
+        typename result_of<decltype(fit::pack_join), 
+            id_<Pack&&>, 
+            result_of<decltype(fit::pack_forward), id_<Ts>...> 
+        >::type,
+        id_<F&&>
+    ) 
+    operator()(Ts&&... xs) && FIT_SFINAE_RETURNS
+    (
+        fit::pack_join
+        (
+            FIT_RETURNS_C_CAST(Pack&&)(FIT_CONST_THIS->get_pack(xs...)), 
+            fit::pack_forward(fit::forward<Ts>(xs)...)
+        )
+        (FIT_RETURNS_C_CAST(F&&)(FIT_CONST_THIS->get_function(xs...)))
+    );
+#endif
 };
 
 
@@ -129,7 +151,7 @@ struct partial_adaptor_join
     FIT_RETURNS_CLASS(partial_adaptor_join);
 
     template<class... Ts>
-    constexpr auto operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    constexpr auto operator()(Ts&&... xs) FIT_CONST_LVALUE_QUALIFIER FIT_SFINAE_RETURNS
     (
         partial
         (
@@ -137,6 +159,18 @@ struct partial_adaptor_join
             fit::pack_join(FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(xs...)), fit::pack_decay(fit::forward<Ts>(xs)...))
         )
     );
+
+#if FIT_HAS_RVALUE_THIS
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) && FIT_SFINAE_RETURNS
+    (
+        partial
+        (
+            FIT_RETURNS_C_CAST(F&&)(FIT_CONST_THIS->get_function(xs...)), 
+            fit::pack_join(FIT_RETURNS_C_CAST(Pack&&)(FIT_CONST_THIS->get_pack(xs...)), fit::pack_decay(fit::forward<Ts>(xs)...))
+        )
+    );
+#endif
 };
 template<class Derived, class F>
 struct partial_adaptor_pack
@@ -154,7 +188,7 @@ struct partial_adaptor_pack
     FIT_RETURNS_CLASS(partial_adaptor_pack);
 
     template<class... Ts>
-    constexpr auto operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    constexpr auto operator()(Ts&&... xs) FIT_CONST_LVALUE_QUALIFIER FIT_SFINAE_RETURNS
     (
         partial
         (
@@ -89,7 +89,7 @@ struct pipe_closure : F, Pack
         return *this;
     }
 
-    template<class A>
+    template<class A, class Self=const pipe_closure&>
     struct invoke
     {
         A a;
@@ -98,20 +98,32 @@ struct pipe_closure : F, Pack
         constexpr invoke(X&& x, const pipe_closure * self) : a(fit::forward<X>(x)), self(self)
         {}
 
+        // The function is called as an rvalue when the closure is an rvalue
+        typedef typename std::conditional<
+            std::is_rvalue_reference<Self>::value, F&&, const F&
+        >::type function_type;
+
         FIT_RETURNS_CLASS(invoke);
 
         template<class... Ts>
-        constexpr FIT_SFINAE_RESULT(const F&, id_<A>, id_<Ts>...) 
+        constexpr FIT_SFINAE_RESULT(function_type, id_<A>, id_<Ts>...) 
         operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
-        (FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->self->base_function(xs...))(fit::forward<A>(a), fit::forward<Ts>(xs)...));
+        ((FIT_RETURNS_C_CAST(function_type)(FIT_CONST_THIS->self->base_function(xs...)))(fit::forward<A>(a), fit::forward<Ts>(xs)...));
     };
 
     FIT_RETURNS_CLASS(pipe_closure);
 
     template<class A>
     constexpr FIT_SFINAE_RESULT(const Pack&, id_<invoke<A&&>>) 
-    operator()(A&& a) const FIT_SFINAE_RETURNS
+    operator()(A&& a) FIT_CONST_LVALUE_QUALIFIER FIT_SFINAE_RETURNS
     (FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(a))(invoke<A&&>(fit::forward<A>(a), FIT_CONST_THIS)));
+
+#if FIT_HAS_RVALUE_THIS
+    template<class A>
+    constexpr FIT_SFINAE_RESULT(Pack&&, id_<invoke<A&&, pipe_closure&&>>) 
+    operator()(A&& a) && FIT_SFINAE_RETURNS
+    ((FIT_RETURNS_C_CAST(Pack&&)(FIT_CONST_THIS->get_pack(a)))(invoke<A&&, pipe_closure&&>(fit::forward<A>(a), FIT_CONST_THIS)));
+#endif
 };
 
 template<class F, class Pack>
@@ -141,6 +153,12 @@ template<class A, class F, class Pack>
 constexpr auto operator|(A&& a, const pipe_closure<F, Pack>& p) FIT_RETURNS
 (p(fit::forward<A>(a)));
 
+#if FIT_HAS_RVALUE_THIS
+template<class A, class F, class Pack>
+constexpr auto operator|(A&& a, pipe_closure<F, Pack>&& p) FIT_RETURNS
+(fit::move(p)(fit::forward<A>(a)));
+#endif
+
 }
 
 template<class F>
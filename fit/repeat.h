@@ -17,6 +17,16 @@
 /// The `repeat` function decorator will repeatedly apply a function a given
 /// number of times.
 /// 
+/// When the number of times is an `IntegralConstant`, the calls are expanded
+/// at compile-time. When it is an integer that is only known at runtime, the
+/// function is applied in a loop instead, over a state value that has the
+/// type of the argument, so the result of the function must be convertible
+/// back to it. A count that isn't positive returns the argument unchanged.
+/// 
+/// The runtime loop can also be unrolled, by passing `unroll<Factor>(n)` as
+/// the count. Then the function is applied `Factor` times in each iteration,
+/// as it is with an `IntegralConstant`, and the remaining calls are finished
+/// with a plain loop.
 /// 
 /// Synopsis
 /// --------
@@ -24,6 +34,12 @@
 ///     template<class IntegralConstant>
 ///     constexpr repeat_adaptor<IntegralConstant> repeat(IntegralConstant);
 /// 
+///     template<class Integer>
+///     constexpr repeat_adaptor<Integer> repeat(Integer);
+/// 
+///     template<int Factor, class T>
+///     constexpr repeat_unroll<Factor, T> unroll(T);
+/// 
 /// Requirements
 /// ------------
 /// 
@@ -31,6 +47,10 @@
 /// 
 /// * IntegralConstant
 /// 
+/// Integer must be:
+/// 
+/// * An integral type
+/// 
 /// Example
 /// -------
 /// 
@@ -46,6 +66,10 @@
 ///     constexpr auto increment_by_5 = fit::repeat(std::integral_constant<int, 5>())(increment());
 ///     assert(increment_by_5(1) == 6);
 /// 
+///     int n = 5;
+///     assert(fit::repeat(n)(increment())(1) == 6);
+///     assert(fit::repeat(fit::unroll<4>(n))(increment())(1) == 6);
+/// 
 
 #include <fit/always.h>
 #include <fit/detail/delegate.h>
@@ -55,29 +79,79 @@
 #include <fit/detail/static_const_var.h>
 #include <fit/decorate.h>
 
-namespace fit { namespace detail {
+namespace fit { 
+
+// Holds a count, or a predicate for repeat_while, to unroll by Factor
+template<int Factor, class T>
+struct repeat_unroll
+{
+    static_assert(Factor > 0, "The unroll factor must be positive");
+    T data;
+
+    constexpr repeat_unroll(T x) : data(fit::move(x))
+    {}
+};
+
+template<int Factor, class T>
+constexpr repeat_unroll<Factor, T> unroll(T x)
+{
+    return repeat_unroll<Factor, T>(fit::move(x));
+}
+
+namespace detail {
 
+// Applies a unary function N times, by splitting N in half, so the depth of
+// the instantiations is logarithmic in N, and the same few instantiations are
+// reused when the function returns the same type
 template<int N>
-struct repeater
+struct repeater_unary
 {
-    template<class F, class... Ts>
-    constexpr FIT_SFINAE_RESULT(repeater<N-1>, id_<const F&>, result_of<const F&, id_<Ts>...>) 
-    operator()(const F& f, Ts&&... xs) const FIT_SFINAE_RETURNS
+    template<class F, class T>
+    constexpr FIT_SFINAE_RESULT(repeater_unary<N/2>, id_<const F&>, result_of<repeater_unary<N - N/2>, id_<const F&>, id_<T>>) 
+    operator()(const F& f, T&& x) const FIT_SFINAE_RETURNS
     (
-        repeater<N-1>()(f, f(fit::forward<Ts>(xs)...))
+        repeater_unary<N/2>()(f, repeater_unary<N - N/2>()(f, fit::forward<T>(x)))
     );
 };
 
 template<>
-struct repeater<0>
+struct repeater_unary<1>
+{
+    template<class F, class T>
+    constexpr FIT_SFINAE_RESULT(const F&, id_<T>) 
+    operator()(const F& f, T&& x) const FIT_SFINAE_RETURNS
+    (
+        f(fit::forward<T>(x))
+    );
+};
+
+template<>
+struct repeater_unary<0>
 {
     template<class F, class T>
     constexpr T operator()(const F&, T&& x) const
     {
-        return x;
+        return fit::forward<T>(x);
     }
 };
 
+// The first call takes all of the arguments, the rest take the result
+template<int N>
+struct repeater
+{
+    template<class F, class... Ts>
+    constexpr FIT_SFINAE_RESULT(repeater_unary<N-1>, id_<const F&>, result_of<const F&, id_<Ts>...>) 
+    operator()(const F& f, Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        repeater_unary<N-1>()(f, f(fit::forward<Ts>(xs)...))
+    );
+};
+
+template<>
+struct repeater<0>
+: repeater_unary<0>
+{};
+
 struct repeat_decorator
 {
     template<class T, class F, class... Ts>
@@ -89,6 +163,26 @@ struct repeat_decorator
             fit::forward<Ts>(xs)...
         )
     );
+
+    template<class Integer, class F, class T, class State=typename std::decay<T>::type, 
+        typename std::enable_if<(std::is_integral<Integer>::value), int>::type = 0>
+    State operator()(Integer n, const F& f, T&& x) const
+    {
+        State state = fit::forward<T>(x);
+        for(;n > 0;--n) state = f(fit::move(state));
+        return state;
+    }
+
+    template<int Factor, class Integer, class F, class T, class State=typename std::decay<T>::type, 
+        typename std::enable_if<(std::is_integral<Integer>::value), int>::type = 0>
+    State operator()(const repeat_unroll<Factor, Integer>& u, const F& f, T&& x) const
+    {
+        State state = fit::forward<T>(x);
+        Integer n = u.data;
+        for(;n >= Factor;n -= Factor) state = detail::repeater<Factor>()(f, fit::move(state));
+        for(;n > 0;--n) state = f(fit::move(state));
+        return state;
+    }
 };
 
 }
@@ -18,6 +18,16 @@
 /// the predicate returns an integral constant that is true. As such, the
 /// predicate must be depedently-typed since it is never called at runtime.
 /// 
+/// When the predicate returns a runtime value, such as a `bool`, the function
+/// is applied in a loop instead, while the predicate is true for the current
+/// state, so it may not be applied at all. The state has the type of the
+/// argument, so the result of the function must be convertible back to it.
+/// There is no recursion, and no instantiation for each step.
+/// 
+/// The runtime loop can be bounded with `limit<Max>(predicate)`, then the
+/// function is applied at most `Max` times. It can also be unrolled with
+/// `unroll<Factor>(predicate)`, so the loop does `Factor` steps in each
+/// iteration, and both can be combined as `limit<Max>(unroll<Factor>(predicate))`.
 /// 
 /// Synopsis
 /// --------
@@ -25,6 +35,9 @@
 ///     template<class Predicate>
 ///     constexpr auto repeat_while(Predicate predicate);
 /// 
+///     template<int Max, class Predicate>
+///     constexpr repeat_limit<Max, Predicate> limit(Predicate predicate);
+/// 
 /// Requirements
 /// ------------
 /// 
@@ -64,23 +77,73 @@
 ///     constexpr auto increment_until_6 = fit::repeat_while(not_6())(increment());
 ///     static_assert(std::is_same<six, decltype(increment_until_6(one()))>::value, "Error");
 /// 
+///     struct less_than_6
+///     {
+///         bool operator()(int x) const
+///         {
+///             return x < 6;
+///         }
+///     };
+/// 
+///     struct increment_int
+///     {
+///         int operator()(int x) const
+///         {
+///             return x + 1;
+///         }
+///     };
+/// 
+///     assert(fit::repeat_while(less_than_6())(increment_int())(1) == 6);
+///     assert(fit::repeat_while(fit::limit<3>(less_than_6()))(increment_int())(1) == 4);
+/// 
 
 #include <fit/always.h>
 #include <fit/detail/delegate.h>
 #include <fit/detail/result_of.h>
 #include <fit/detail/move.h>
 #include <fit/decorate.h>
+#include <fit/repeat.h>
+#include <fit/detail/holder.h>
 #include <fit/detail/sfinae.h>
 #include <fit/detail/static_const_var.h>
 
-namespace fit { namespace detail {
+namespace fit { 
+
+template<int Max, class T>
+struct repeat_limit
+{
+    static_assert(Max >= 0, "The limit must not be negative");
+    T data;
+
+    constexpr repeat_limit(T x) : data(fit::move(x))
+    {}
+};
+
+template<int Max, class T>
+constexpr repeat_limit<Max, T> limit(T x)
+{
+    return repeat_limit<Max, T>(fit::move(x));
+}
+
+namespace detail {
+
+template<class P, class Args, class=void>
+struct compute_predicate_impl
+{};
 
 template<class P, class... Ts>
-struct compute_predicate
+struct compute_predicate_impl<P, holder<Ts...>, typename holder<
+    decltype(std::declval<P>()(std::declval<Ts>()...))
+>::type>
 {
     typedef decltype(std::declval<P>()(std::declval<Ts>()...)) type;
 };
 
+template<class P, class... Ts>
+struct compute_predicate
+: compute_predicate_impl<P, holder<Ts...>>
+{};
+
 template<bool B>
 struct while_repeater
 {
@@ -106,6 +169,100 @@ struct while_repeater<false>
     }
 };
 
+template<class T, class=void>
+struct is_constant_predicate
+: std::false_type
+{};
+
+template<class T>
+struct is_constant_predicate<T, typename holder<decltype(std::decay<T>::type::value)>::type>
+: std::true_type
+{};
+
+// The unroll factor, the maximum number of steps (-1 for none), and the
+// predicate of a runtime loop
+template<class T>
+struct while_loop
+{
+    static const int factor = 1;
+    static const int max = -1;
+
+    static constexpr const T& predicate(const T& x)
+    {
+        return x;
+    }
+};
+
+template<int Factor, class T>
+struct while_loop<repeat_unroll<Factor, T>>
+: while_loop<T>
+{
+    static const int factor = Factor;
+
+    static constexpr auto predicate(const repeat_unroll<Factor, T>& x) FIT_RETURNS
+    (
+        while_loop<T>::predicate(x.data)
+    );
+};
+
+template<int Max, class T>
+struct while_loop<repeat_limit<Max, T>>
+: while_loop<T>
+{
+    static const int max = Max;
+
+    static constexpr auto predicate(const repeat_limit<Max, T>& x) FIT_RETURNS
+    (
+        while_loop<T>::predicate(x.data)
+    );
+};
+
+// Does N steps, and returns false as soon as the predicate is false
+template<int N>
+struct while_unroller
+{
+    template<class P, class F, class State>
+    bool operator()(const P& p, const F& f, State& state) const
+    {
+        if (!p(static_cast<const State&>(state))) return false;
+        state = f(fit::move(state));
+        return while_unroller<N-1>()(p, f, state);
+    }
+};
+
+template<>
+struct while_unroller<0>
+{
+    template<class P, class F, class State>
+    bool operator()(const P&, const F&, State&) const
+    {
+        return true;
+    }
+};
+
+template<int Factor, class P, class F, class State>
+State while_loop_run(const P& p, const F& f, State state, std::integral_constant<int, -1>)
+{
+    while(while_unroller<Factor>()(p, f, state));
+    return state;
+}
+
+template<int Factor, class P, class F, class State, int Max>
+State while_loop_run(const P& p, const F& f, State state, std::integral_constant<int, Max>)
+{
+    int n = Max;
+    for(;n >= Factor;n -= Factor) if (!while_unroller<Factor>()(p, f, state)) return state;
+    for(;n > 0 && p(static_cast<const State&>(state));--n) state = f(fit::move(state));
+    return state;
+}
+
+template<class T, class State>
+struct is_runtime_predicate
+: std::integral_constant<bool, !is_constant_predicate<
+    decltype(while_loop<T>::predicate(std::declval<const T&>())(std::declval<const State&>()))
+>::value>
+{};
+
 struct repeat_while_decorator
 {
     template<class P, class F, class... Ts>
@@ -120,6 +277,18 @@ struct repeat_while_decorator
             fit::forward<Ts>(xs)...
         )
     );
+
+    template<class T, class F, class X, class State=typename std::decay<X>::type, 
+        typename std::enable_if<(is_runtime_predicate<T, State>::value), int>::type = 0>
+    State operator()(const T& data, const F& f, X&& x) const
+    {
+        return detail::while_loop_run<while_loop<T>::factor>(
+            while_loop<T>::predicate(data), 
+            f, 
+            State(fit::forward<X>(x)), 
+            std::integral_constant<int, while_loop<T>::max>()
+        );
+    }
 };
 
 }
@@ -124,6 +124,33 @@
 #include <utility>
 #include <fit/detail/forward.h>
 
+// A constexpr member function is implicitly const in C++11, so an rvalue
+// call operator can only be overloaded with relaxed constexpr
+#ifndef FIT_HAS_RVALUE_THIS
+#if __cplusplus >= 201402L
+#define FIT_HAS_RVALUE_THIS 1
+#else
+#define FIT_HAS_RVALUE_THIS 0
+#endif
+#endif
+
+// Qualifies the const call operator of a function object, so it can be
+// overloaded with an rvalue call operator when ref qualifiers are supported
+#if FIT_HAS_RVALUE_THIS
+#define FIT_CONST_LVALUE_QUALIFIER const&
+#else
+#define FIT_CONST_LVALUE_QUALIFIER const
+#endif
+
+// Casts a member that the const call operator passes along. Without ref
+// qualifiers the const call operator is also used for rvalues, so the member
+// is moved, which is how these adaptors behave in C++11.
+#if FIT_HAS_RVALUE_THIS
+#define FIT_CONST_LVALUE_CAST(...) FIT_RETURNS_STATIC_CAST(const __VA_ARGS__&)
+#else
+#define FIT_CONST_LVALUE_CAST(...) FIT_RETURNS_C_CAST(__VA_ARGS__&&)
+#endif
+
 #define FIT_EAT(...)
 #define FIT_REM(...) __VA_ARGS__
 
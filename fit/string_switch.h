@@ -0,0 +1,386 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    string_switch.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_STRING_SWITCH_H
+#define FIT_GUARD_STRING_SWITCH_H
+
+/// string_switch
+/// =============
+///
+/// Description
+/// -----------
+///
+/// The `string_switch` function adaptor chooses a function by a string key.
+/// It is built from cases, made with `string_case`, which pair a string
+/// literal with a function, and a fallback function, which is the last
+/// argument. So `string_switch(string_case(k, f)..., g)(s, xs...)` calls the
+/// `f` whose key is equal to `s` with `xs...`, and when no key is equal, it
+/// calls `g(s, xs...)`, like the last function of a `conditional`. The string
+/// can be a `const char*`, or anything with `data()` and `size()`, such as a
+/// `std::string` or a `std::string_view`.
+///
+/// The keys are placed in a perfect hash table when the adaptor is
+/// constructed, which happens at compile time when it is declared
+/// `constexpr`. So looking a string up hashes it once, and compares it with
+/// only one key. The matching function is then called through a table, with
+/// no allocation.
+///
+/// The keys are not copied, so they should be string literals, and they must
+/// all be different. Equal keys are a compile error when the adaptor is
+/// declared `constexpr`, and otherwise `std::invalid_argument` is thrown when
+/// it is constructed. The results must have a common type, which is what is
+/// returned. The hash table is built with relaxed `constexpr`, so this
+/// requires C++14, which can be checked with the `FIT_HAS_STRING_SWITCH`
+/// macro.
+///
+/// Synopsis
+/// --------
+///
+///     template<std::size_t N, class F>
+///     constexpr string_case_type<F> string_case(const char (&key)[N], F f);
+///
+///     template<class... Fs, class G>
+///     constexpr string_switch_adaptor<G, Fs...> string_switch(string_case_type<Fs>... cases, G fallback);
+///
+/// Semantics
+/// ---------
+///
+///     assert(string_switch(string_case(k, f)..., g)(s, xs...) == (s == k ? f(xs...) : ... : g(s, xs...)));
+///
+/// Requirements
+/// ------------
+///
+/// Fs and G must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     auto calc = fit::string_switch(
+///         fit::string_case("add", [](int x, int y) { return x + y; }),
+///         fit::string_case("sub", [](int x, int y) { return x - y; }),
+///         [](const std::string&, int, int) { return 0; }
+///     );
+///     assert(calc(std::string("sub"), 3, 1) == 2);
+///     assert(calc(std::string("mul"), 3, 1) == 0);
+///
+
+#ifndef FIT_HAS_STRING_SWITCH
+#if __cplusplus >= 201402L
+#define FIT_HAS_STRING_SWITCH 1
+#else
+#define FIT_HAS_STRING_SWITCH 0
+#endif
+#endif
+
+#if FIT_HAS_STRING_SWITCH
+
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/jump_table.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <fit/returns.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+struct string_switch_key
+{
+    const char* data;
+    std::size_t size;
+
+    constexpr string_switch_key(const char* d, std::size_t n) : data(d), size(n)
+    {}
+
+    constexpr bool same(string_switch_key x) const
+    {
+        if (size != x.size) return false;
+        for(std::size_t i = 0; i < size; i++) if (data[i] != x.data[i]) return false;
+        return true;
+    }
+
+    bool operator==(string_switch_key x) const
+    {
+        return size == x.size && std::memcmp(data, x.data, size) == 0;
+    }
+};
+
+inline string_switch_key make_string_switch_key(const char* s)
+{
+    return string_switch_key(s, std::strlen(s));
+}
+
+template<class S>
+auto make_string_switch_key(const S& s) FIT_RETURNS
+(
+    string_switch_key(s.data(), s.size())
+);
+
+// FNV-1a, with a final mix so the high bits depend on every character
+constexpr std::uint64_t string_switch_hash(string_switch_key k, std::uint64_t seed)
+{
+    std::uint64_t h = 14695981039346656037ull ^ (seed * 0x9e3779b97f4a7c15ull);
+    for(std::size_t i = 0; i < k.size; i++)
+    {
+        h ^= static_cast<unsigned char>(k.data[i]);
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 29;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+constexpr std::size_t string_switch_slot_count(std::size_t n)
+{
+    std::size_t r = 1;
+    while(r < 2 * n) r *= 2;
+    return r;
+}
+
+// A perfect hash by hash and displace. The keys are split into small
+// buckets by one part of the hash, and every bucket gets a displacement
+// that moves its keys to free slots. Larger buckets are placed first, while
+// there are more free slots. If some bucket can't be placed, another seed
+// is tried.
+template<std::size_t N>
+struct string_switch_index
+{
+    static constexpr std::size_t slot_count = string_switch_slot_count(N);
+    static constexpr std::size_t bucket_count = slot_count < 4 ? 1 : slot_count / 4;
+
+    string_switch_key keys[N];
+    // An empty slot refers to the first key, which never matches a string
+    // that hashes to that slot
+    std::size_t slots[slot_count];
+    std::size_t displacements[bucket_count];
+    std::uint64_t seed;
+
+    template<class... Ks>
+    constexpr string_switch_index(Ks... ks) : keys{ks...}, slots{}, displacements{}, seed(0)
+    {
+        // Throwing is not a constant expression, so this fails to compile
+        // when the index is built at compile time
+        if (!this->unique()) throw std::invalid_argument("The keys of string_switch must be different");
+        while(!this->place()) seed++;
+    }
+
+    static constexpr std::size_t bucket(std::uint64_t h)
+    {
+        return (h >> 32) & (bucket_count - 1);
+    }
+
+    static constexpr std::size_t slot(std::uint64_t h, std::size_t d)
+    {
+        return (std::size_t(std::uint32_t(h)) + d * std::size_t((h >> 48) | 1)) & (slot_count - 1);
+    }
+
+    constexpr bool unique() const
+    {
+        for(std::size_t i = 0; i < N; i++)
+            for(std::size_t j = i + 1; j < N; j++)
+                if (keys[i].same(keys[j])) return false;
+        return true;
+    }
+
+    constexpr bool place()
+    {
+        std::uint64_t hashes[N] = {};
+        std::size_t sizes[bucket_count] = {};
+        std::size_t largest = 0;
+        for(std::size_t i = 0; i < N; i++)
+        {
+            hashes[i] = string_switch_hash(keys[i], seed);
+            std::size_t n = ++sizes[bucket(hashes[i])];
+            if (n > largest) largest = n;
+        }
+        bool used[slot_count] = {};
+        for(std::size_t i = 0; i < slot_count; i++) slots[i] = 0;
+        for(std::size_t n = largest; n > 0; n--)
+        {
+            for(std::size_t b = 0; b < bucket_count; b++)
+            {
+                if (sizes[b] != n) continue;
+                bool placed = false;
+                for(std::size_t d = 0; d < 2 * slot_count && !placed; d++)
+                {
+                    placed = this->try_place(hashes, used, b, d);
+                }
+                if (!placed) return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr bool try_place(const std::uint64_t* hashes, bool* used, std::size_t b, std::size_t d)
+    {
+        std::size_t taken[N] = {};
+        std::size_t count = 0;
+        for(std::size_t i = 0; i < N; i++)
+        {
+            if (bucket(hashes[i]) != b) continue;
+            std::size_t s = slot(hashes[i], d);
+            if (used[s])
+            {
+                for(std::size_t j = 0; j < count; j++) used[taken[j]] = false;
+                return false;
+            }
+            used[s] = true;
+            taken[count++] = s;
+        }
+        displacements[b] = d;
+        for(std::size_t i = 0; i < N; i++)
+        {
+            if (bucket(hashes[i]) == b) slots[slot(hashes[i], d)] = i;
+        }
+        return true;
+    }
+
+    // Returns N when no key is equal to the string
+    std::size_t find(string_switch_key k) const
+    {
+        std::uint64_t h = string_switch_hash(k, seed);
+        std::size_t i = slots[slot(h, displacements[bucket(h)])];
+        return keys[i] == k ? i : N;
+    }
+};
+
+template<int N, class F>
+struct string_switch_leaf : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(string_switch_leaf, detail::callable_base<F>);
+};
+
+template<int N, class F>
+constexpr const detail::callable_base<F>& string_switch_get(const string_switch_leaf<N, F>& x)
+{
+    return x;
+}
+
+struct string_switch_invoker
+{
+    template<int N, class Self, class... Ts>
+    static constexpr auto apply(const Self& self, Ts&&... xs) FIT_RETURNS
+    (
+        string_switch_get<N>(self)(fit::forward<Ts>(xs)...)
+    );
+};
+
+}
+
+template<class F>
+struct string_case_type
+{
+    detail::string_switch_key key;
+    F f;
+};
+
+template<std::size_t N, class F>
+constexpr string_case_type<F> string_case(const char (&key)[N], F f)
+{
+    return string_case_type<F>{detail::string_switch_key(key, N - 1), fit::move(f)};
+}
+
+namespace detail {
+
+template<class Seq, class Fallback, class... Fs>
+struct string_switch_base;
+
+template<int... Ns, class Fallback, class... Fs>
+struct string_switch_base<seq<Ns...>, Fallback, Fs...>
+: string_switch_leaf<Ns, Fs>..., string_switch_leaf<sizeof...(Fs), Fallback>
+{
+    static_assert(sizeof...(Fs) > 0, "A string_switch needs at least one case");
+
+    string_switch_index<sizeof...(Fs)> index;
+
+    constexpr string_switch_base(string_case_type<Fs>... cs, Fallback g)
+    : string_switch_leaf<Ns, Fs>(fit::move(cs.f))...,
+      string_switch_leaf<sizeof...(Fs), Fallback>(fit::move(g)),
+      index(cs.key...)
+    {}
+
+    template<class R, class... Ts>
+    R call(std::size_t i, Ts&&... xs) const
+    {
+        return jump_table<string_switch_invoker, seq<Ns...>, const string_switch_base&, Ts...>::template call<R>(
+            i, *this, fit::forward<Ts>(xs)...
+        );
+    }
+};
+
+}
+
+template<class Fallback, class... Fs>
+struct string_switch_adaptor
+: detail::string_switch_base<typename detail::gens<sizeof...(Fs)>::type, Fallback, Fs...>
+{
+    typedef detail::string_switch_base<typename detail::gens<sizeof...(Fs)>::type, Fallback, Fs...> base;
+
+    FIT_INHERIT_CONSTRUCTOR(string_switch_adaptor, base);
+
+    template<class S, class... Ts>
+    struct result
+    : std::common_type<
+        decltype(std::declval<const detail::callable_base<Fs>&>()(std::declval<Ts>()...))...,
+        decltype(std::declval<const detail::callable_base<Fallback>&>()(std::declval<S>(), std::declval<Ts>()...))
+    >
+    {};
+
+    template<class S, class... Ts>
+    typename result<S&&, Ts&&...>::type operator()(S&& s, Ts&&... xs) const
+    {
+        typedef typename result<S&&, Ts&&...>::type result_type;
+        std::size_t i = this->index.find(detail::make_string_switch_key(s));
+        if (i == sizeof...(Fs)) return detail::string_switch_get<sizeof...(Fs)>(*this)(fit::forward<S>(s), fit::forward<Ts>(xs)...);
+        return this->template call<result_type>(i, fit::forward<Ts>(xs)...);
+    }
+};
+
+namespace detail {
+
+template<class... Fs>
+struct string_switch_cases
+{};
+
+// The fallback is the last argument, so the cases are collected before it
+template<class Cases, class... Ts>
+struct string_switch_of;
+
+template<class... Fs, class G>
+struct string_switch_of<string_switch_cases<Fs...>, G>
+{
+    typedef string_switch_adaptor<G, Fs...> type;
+};
+
+template<class... Fs, class F, class T, class... Ts>
+struct string_switch_of<string_switch_cases<Fs...>, string_case_type<F>, T, Ts...>
+: string_switch_of<string_switch_cases<Fs..., F>, T, Ts...>
+{};
+
+}
+
+template<class... Ts>
+constexpr typename detail::string_switch_of<detail::string_switch_cases<>, Ts...>::type string_switch(Ts... xs)
+{
+    return typename detail::string_switch_of<detail::string_switch_cases<>, Ts...>::type(fit::move(xs)...);
+}
+
+}
+
+#endif
+
+#endif
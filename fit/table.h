@@ -0,0 +1,88 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    table.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_TABLE_H
+#define FIT_GUARD_TABLE_H
+
+/// table
+/// =====
+///
+/// Description
+/// -----------
+///
+/// The `table` function evaluates a function over the indices `0` to `N-1`,
+/// and returns the results in a `std::array`. When the function is
+/// `constexpr`, so is the table, so a lookup table can be generated at
+/// compile time from a function object, and looking a value up at runtime is
+/// just a load.
+///
+/// Synopsis
+/// --------
+///
+///     template<std::size_t N, class F>
+///     constexpr std::array<R, N> table(F f);
+///
+/// Where `R` is the decayed result of calling `f` with a `std::size_t`.
+///
+/// Semantics
+/// ---------
+///
+///     assert(table<N>(f)[i] == f(i));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+///
+/// Example
+/// -------
+///
+///     struct square
+///     {
+///         constexpr std::size_t operator()(std::size_t x) const
+///         {
+///             return x * x;
+///         }
+///     };
+///
+///     constexpr std::array<std::size_t, 4> squares = fit::table<4>(square());
+///     static_assert(squares[3] == 9, "Failed");
+///
+
+#include <fit/detail/seq.h>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+template<class F>
+struct table_result
+: std::decay<decltype(std::declval<const F&>()(std::size_t(0)))>
+{};
+
+template<class R, class F, int... Ns>
+constexpr std::array<R, sizeof...(Ns)> make_table(const F& f, seq<Ns...>)
+{
+    return {{ f(std::size_t(Ns))... }};
+}
+
+}
+
+template<std::size_t N, class F>
+constexpr std::array<typename detail::table_result<F>::type, N> table(F f)
+{
+    return detail::make_table<typename detail::table_result<F>::type>(f, typename detail::gens<N>::type());
+}
+
+}
+
+#endif
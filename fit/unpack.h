@@ -71,7 +71,9 @@
 /// ===============
 /// 
 /// How to unpack a sequence can be defined by specializing `unpack_sequence`.
-/// By default, `std::tuple` can be used with unpack.
+/// By default, `std::tuple`, `std::pair` and `std::array` can be used with
+/// unpack. The elements are moved out of the sequence only when it is passed
+/// as an rvalue.
 /// 
 /// Synopsis
 /// --------
@@ -94,7 +96,9 @@
 /// 
 
 #include <fit/returns.h>
+#include <array>
 #include <tuple>
+#include <utility>
 #include <fit/detail/seq.h>
 #include <fit/capture.h>
 #include <fit/always.h>
@@ -256,36 +260,55 @@ make_tuple_gens(const Sequence&)
     return {};
 }
 
-template<class F, class... Ts, int ...N>
-constexpr auto unpack_tuple(F&& f, std::tuple<Ts...> && t, seq<N...>) FIT_RETURNS
-(
-    f(fit::forward<Ts>(std::get<N>(t))...)
-);
+// Elements that are references are passed as they were declared, otherwise
+// they take on the value category of the sequence, so they are only moved
+// out of an rvalue sequence
+template<class T, class X, typename std::enable_if<(std::is_reference<T>::value), int>::type = 0>
+constexpr T&& unpack_element(X&& x)
+{
+    return static_cast<T&&>(x);
+}
 
-template<class F, class... Ts, int ...N>
-constexpr auto unpack_tuple(F&& f, std::tuple<Ts...> & t, seq<N...>) FIT_RETURNS
-(
-    f(fit::forward<Ts>(std::get<N>(t))...)
-);
+template<class T, class X, typename std::enable_if<(!std::is_reference<T>::value), int>::type = 0>
+constexpr X&& unpack_element(X&& x)
+{
+    return fit::forward<X>(x);
+}
 
-template<class F, class... Ts, int ...N>
-constexpr auto unpack_tuple(F&& f, const std::tuple<Ts...> & t, seq<N...>) FIT_RETURNS
+template<class F, class Sequence, int ...N>
+constexpr auto unpack_tuple(F&& f, Sequence&& t, seq<N...>) FIT_RETURNS
 (
-    f(fit::forward<Ts>(std::get<N>(t))...)
+    f(unpack_element<
+        typename std::tuple_element<N, typename std::remove_cv<typename std::remove_reference<Sequence>::type>::type>::type
+    >(std::get<N>(fit::forward<Sequence>(t)))...)
 );
 
-}
-
-template<class... Ts>
-struct unpack_sequence<std::tuple<Ts...>>
+struct unpack_tuple_sequence
 {
     template<class F, class S>
     constexpr static auto apply(F&& f, S&& t) FIT_RETURNS
     (
-        detail::unpack_tuple(fit::forward<F>(f), t, detail::make_tuple_gens(t))
+        detail::unpack_tuple(fit::forward<F>(f), fit::forward<S>(t), detail::make_tuple_gens(t))
     );
 };
 
+}
+
+template<class... Ts>
+struct unpack_sequence<std::tuple<Ts...>>
+: detail::unpack_tuple_sequence
+{};
+
+template<class T, class U>
+struct unpack_sequence<std::pair<T, U>>
+: detail::unpack_tuple_sequence
+{};
+
+template<class T, std::size_t N>
+struct unpack_sequence<std::array<T, N>>
+: detail::unpack_tuple_sequence
+{};
+
 template<class T, class... Ts>
 struct unpack_sequence<detail::pack_base<T, Ts...>>
 {
@@ -0,0 +1,204 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    unpack_n.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_UNPACK_N_H
+#define FIT_GUARD_UNPACK_N_H
+
+/// unpack_n
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `unpack_n` function adaptor takes a range whose size is only known at
+/// runtime, and calls the function with its elements as the arguments, so
+/// `unpack_n<MaxN>(f)(r)` calls `f(r[0], ..., r[n-1])`, where `n` is
+/// `r.size()`. A pointer and a size can also be passed instead of a range.
+///
+/// The call is dispatched through a table of `MaxN+1` entries, one for each
+/// size, which is generated at compile-time, so no allocation or recursion
+/// happens on each call. The elements are moved when the range is an rvalue.
+///
+/// The function must be callable with every number of elements from `0` up
+/// to `MaxN`, and the results must have a common type, which is what is
+/// returned. A `conditional` adaptor can be used to provide a fallback for
+/// sizes the function doesn't handle. When the size of the range is larger
+/// than `MaxN`, `std::out_of_range` is thrown.
+///
+/// Synopsis
+/// --------
+///
+///     template<int MaxN, class F>
+///     constexpr unpack_n_adaptor<MaxN, F> unpack_n(F f);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct sum
+///     {
+///         template<class... Ts>
+///         int operator()(Ts... xs) const
+///         {
+///             int r = 0;
+///             for(int x: {0, xs...}) r += x;
+///             return r;
+///         }
+///     };
+///
+///     std::vector<int> v = {1, 2, 3};
+///     assert(fit::unpack_n<4>(sum())(v) == 6);
+///     assert(fit::unpack_n<4>(sum())(v.data(), 2) == 3);
+///
+
+#include <fit/unpack.h>
+#include <fit/always.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/jump_table.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <cstddef>
+#include <stdexcept>
+
+namespace fit {
+
+namespace detail {
+
+// A view of the first N elements of a range, which can be unpacked
+template<int N, class Range>
+struct unpack_n_view
+{
+    Range&& range;
+
+    constexpr unpack_n_view(Range&& r) : range(fit::forward<Range>(r))
+    {}
+};
+
+// Elements are moved out of an rvalue range
+template<class Range, class T, typename std::enable_if<(std::is_lvalue_reference<Range>::value), int>::type = 0>
+constexpr T&& unpack_n_element(T&& x)
+{
+    return fit::forward<T>(x);
+}
+
+template<class Range, class T, typename std::enable_if<(!std::is_lvalue_reference<Range>::value), int>::type = 0>
+constexpr typename std::remove_reference<T>::type&& unpack_n_element(T&& x)
+{
+    return fit::move(x);
+}
+
+template<class F, class Range, int... Ns>
+constexpr auto unpack_n_elements(F&& f, Range&& r, seq<Ns...>) FIT_RETURNS
+(
+    f(unpack_n_element<Range>(r[Ns])...)
+);
+
+// Adapts a pointer and a size to a range
+template<class T>
+struct unpack_n_range
+{
+    T* data;
+    std::size_t n;
+
+    constexpr unpack_n_range(T* p, std::size_t s) : data(p), n(s)
+    {}
+
+    constexpr std::size_t size() const
+    {
+        return n;
+    }
+
+    constexpr T& operator[](std::size_t i) const
+    {
+        return data[i];
+    }
+};
+
+struct unpack_n_invoker
+{
+    template<int N, class F, class Range>
+    static constexpr auto apply(const F& f, Range&& r) FIT_RETURNS
+    (
+        detail::unpack_simple(f, unpack_n_view<N, Range>(fit::forward<Range>(r)))
+    );
+};
+
+template<class F, class Range, class Seq>
+struct unpack_n_table;
+
+template<class F, class Range, int... Ns>
+struct unpack_n_table<F, Range, seq<Ns...>>
+: jump_table<unpack_n_invoker, seq<Ns...>, const F&, Range>
+{
+    typedef jump_table<unpack_n_invoker, seq<Ns...>, const F&, Range> base;
+
+    static typename base::result_type call(const F& f, Range&& r)
+    {
+        if (r.size() >= sizeof...(Ns)) throw std::out_of_range("Range is larger than the maximum size for unpack_n");
+        return base::call(r.size(), f, fit::forward<Range>(r));
+    }
+};
+
+}
+
+template<int N, class Range>
+struct unpack_sequence<detail::unpack_n_view<N, Range>>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        detail::unpack_n_elements(fit::forward<F>(f), fit::forward<Range>(s.range), typename detail::gens<N>::type())
+    );
+};
+
+template<int MaxN, class F>
+struct unpack_n_adaptor : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(unpack_n_adaptor, detail::callable_base<F>);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class Range>
+    struct table
+    : detail::unpack_n_table<detail::callable_base<F>, Range, typename detail::gens<MaxN+1>::type>
+    {};
+
+    template<class Range>
+    typename table<Range&&>::result_type operator()(Range&& r) const
+    {
+        return table<Range&&>::call(this->base_function(r), fit::forward<Range>(r));
+    }
+
+    template<class T>
+    typename table<detail::unpack_n_range<T>&>::result_type operator()(T* p, std::size_t n) const
+    {
+        detail::unpack_n_range<T> r(p, n);
+        return table<detail::unpack_n_range<T>&>::call(this->base_function(p), r);
+    }
+};
+
+template<int MaxN, class F>
+constexpr unpack_n_adaptor<MaxN, F> unpack_n(F f)
+{
+    return unpack_n_adaptor<MaxN, F>(fit::move(f));
+}
+
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    visit.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_VISIT_H
+#define FIT_GUARD_VISIT_H
+
+/// visit
+/// =====
+///
+/// Description
+/// -----------
+///
+/// The `visit` function adaptor calls the function with the active
+/// alternatives of one or more `std::variant`s, so it can be used with a
+/// `match` or `conditional` adaptor to handle each alternative.
+///
+/// The call is dispatched through a table of function pointers, with one
+/// entry for each combination of alternatives, which is generated at
+/// compile-time. So a call is a single indirect call, for any number of
+/// variants. Each entry calls the function directly, so the overload
+/// resolution of `match`, and the ordering of `conditional`, are the same as
+/// calling the function with the alternatives.
+///
+/// The function must be callable with every combination of alternatives,
+/// and the results must have a common type, which is what is returned. If a
+/// variant is valueless, then `std::bad_variant_access` is thrown. This
+/// requires C++17 and `<variant>`, which can be checked with the
+/// `FIT_HAS_STD_VARIANT` macro.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     constexpr visit_adaptor<F> visit(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(visit(f)(vs...) == f(std::get<vs.index()>(vs)...));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [Callable](concepts.md#callable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct circle { double r; };
+///     struct square { double side; };
+///
+///     auto area = fit::visit(fit::match(
+///         [](const circle& c) { return 3.14159 * c.r * c.r; },
+///         [](const square& s) { return s.side * s.side; }
+///     ));
+///
+///     std::variant<circle, square> shape = square{2.0};
+///     assert(area(shape) == 4.0);
+///
+
+#ifndef FIT_HAS_STD_VARIANT
+#if defined(__has_include)
+#if __has_include(<variant>) && __cplusplus >= 201703L
+#define FIT_HAS_STD_VARIANT 1
+#endif
+#endif
+#endif
+
+#ifndef FIT_HAS_STD_VARIANT
+#define FIT_HAS_STD_VARIANT 0
+#endif
+
+#if FIT_HAS_STD_VARIANT
+
+#include <fit/always.h>
+#include <fit/returns.h>
+#include <fit/detail/callable_base.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/jump_table.h>
+#include <fit/detail/make.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+#include <fit/detail/static_constexpr.h>
+#include <cstddef>
+#include <type_traits>
+#include <variant>
+
+namespace fit {
+
+namespace detail {
+
+template<class V>
+struct visit_size
+: std::variant_size<typename std::remove_cv<typename std::remove_reference<V>::type>::type>
+{};
+
+// The table is laid out in row-major order, so the last variant has a
+// stride of one
+template<class... Vs>
+struct visit_shape
+{
+    static constexpr std::size_t size()
+    {
+        return (std::size_t(1) * ... * visit_size<Vs>::value);
+    }
+
+    static constexpr std::size_t alternative(std::size_t flat, std::size_t j)
+    {
+        const std::size_t sizes[] = { visit_size<Vs>::value..., 1 };
+        std::size_t stride = 1;
+        for(std::size_t i = j + 1; i < sizeof...(Vs); i++) stride *= sizes[i];
+        return (flat / stride) % sizes[j];
+    }
+
+    static constexpr std::size_t index(const typename std::remove_reference<Vs>::type&... vs)
+    {
+        std::size_t flat = 0;
+        ((flat = flat * visit_size<Vs>::value + vs.index()), ...);
+        return flat;
+    }
+};
+
+template<std::size_t Flat, class F, int... Js, class... Vs>
+constexpr auto visit_elements(const F& f, seq<Js...>, Vs&&... vs) FIT_RETURNS
+(
+    f(std::get<visit_shape<Vs...>::alternative(Flat, Js)>(fit::forward<Vs>(vs))...)
+);
+
+struct visit_invoker
+{
+    template<int Flat, class F, class... Vs>
+    static constexpr auto apply(const F& f, Vs&&... vs) FIT_RETURNS
+    (
+        visit_elements<Flat>(f, typename gens<sizeof...(Vs)>::type(), fit::forward<Vs>(vs)...)
+    );
+};
+
+template<class F, class Seq, class... Vs>
+struct visit_table
+: jump_table<visit_invoker, Seq, const F&, Vs...>
+{
+    typedef jump_table<visit_invoker, Seq, const F&, Vs...> base;
+
+    static constexpr typename base::result_type call(const F& f, Vs&&... vs)
+    {
+        if ((vs.valueless_by_exception() || ...)) throw std::bad_variant_access();
+        return base::call(visit_shape<Vs...>::index(vs...), f, fit::forward<Vs>(vs)...);
+    }
+};
+
+}
+
+template<class F>
+struct visit_adaptor : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(visit_adaptor, detail::callable_base<F>);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Vs>
+    struct table
+    : detail::visit_table<detail::callable_base<F>, typename detail::gens<detail::visit_shape<Vs...>::size()>::type, Vs...>
+    {};
+
+    template<class... Vs>
+    constexpr typename table<Vs&&...>::result_type operator()(Vs&&... vs) const
+    {
+        return table<Vs&&...>::call(this->base_function(vs...), fit::forward<Vs>(vs)...);
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(visit, detail::make<visit_adaptor>);
+
+}
+
+#endif
+
+#endif
@@ -16,3 +16,29 @@ FIT_TEST_CASE()
     static_assert(std::is_same<decltype(fit::always()(1, 2)), FIT_ALWAYS_VOID_RETURN>::value, "Failed");
 }
 
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(fit::always(std::true_type())(1, 2));
+    STATIC_ASSERT_SAME(decltype(fit::always(std::true_type())(1, 2)), std::true_type);
+    FIT_STATIC_TEST_CHECK(std::is_empty<decltype(fit::always(std::true_type()))>::value);
+}
+
+// An empty final value can't be inherited, so it is held as a member
+struct final_value final
+{
+    constexpr final_value()
+    {}
+
+    constexpr bool operator==(final_value) const
+    {
+        return true;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(fit::always(final_value())(1, 2) == final_value());
+    FIT_TEST_CHECK(fit::always(final_value())(1, 2) == final_value());
+    STATIC_ASSERT_SAME(decltype(fit::always(final_value())(1, 2)), final_value);
+}
@@ -46,3 +46,36 @@ FIT_TEST_CASE()
     FIT_TEST_CHECK(fit::capture(add_member(1))(&add_member::add)(2) == 3);
 }
 
+
+struct string_size
+{
+    std::size_t operator()(std::string s) const
+    {
+        return s.size();
+    }
+};
+
+#if FIT_HAS_RVALUE_THIS
+FIT_TEST_CASE()
+{
+    const auto c = fit::capture(std::string("abc"));
+    auto f = c(string_size());
+    auto g = c(string_size());
+    FIT_TEST_CHECK(f() == 3);
+    FIT_TEST_CHECK(f() == 3);
+    FIT_TEST_CHECK(g() == 3);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto f = fit::capture(copy_counter(&copies, &moves))(by_value_class());
+    copies = 0;
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(copies == 1);
+    copies = 0;
+    FIT_TEST_CHECK(std::move(f)(1) == 2);
+    FIT_TEST_CHECK(copies == 0);
+}
+#endif
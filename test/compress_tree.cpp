@@ -0,0 +1,88 @@
+#include <fit/compress_tree.h>
+#include <fit/compress.h>
+#include <string>
+#include "test.h"
+
+struct max_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x > y ? x : y;
+    }
+};
+
+struct sum_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::compress_tree(max_f(), 0)(2, 3, 4, 5) == 5);
+    FIT_TEST_CHECK(fit::compress_tree(max_f(), 0)(5, 4, 3, 2) == 5);
+    FIT_TEST_CHECK(fit::compress_tree(max_f(), 0)(2, 3, 5, 4) == 5);
+
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f(), 0)(2, 3, 4, 5) == 5);
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f(), 0)(5, 4, 3, 2) == 5);
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f(), 0)(2, 3, 5, 4) == 5);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::compress_tree(max_f(), 0)() == 0);
+    FIT_TEST_CHECK(fit::compress_tree(max_f(), 0)(5) == 5);
+
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f(), 0)() == 0);
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f(), 0)(5) == 5);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::compress_tree(max_f())(5) == 5);
+    FIT_TEST_CHECK(fit::compress_tree(max_f())(2, 3, 4, 5) == 5);
+    FIT_TEST_CHECK(fit::compress_tree(max_f())(5, 4, 3, 2) == 5);
+    FIT_TEST_CHECK(fit::compress_tree(sum_f())(1, 2, 3) == 6);
+
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f())(5) == 5);
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(max_f())(2, 3, 4, 5) == 5);
+    FIT_STATIC_TEST_CHECK(fit::compress_tree(sum_f())(1, 2, 3, 4, 5, 6, 7) == 28);
+}
+
+FIT_TEST_CASE()
+{
+    // The order of the arguments is kept, so associative operations that
+    // aren't commutative give the same result as compress
+    std::string a = "a";
+    FIT_TEST_CHECK(fit::compress_tree(sum_f())(a, std::string("b"), std::string("c"), std::string("d"), std::string("e")) == "abcde");
+    FIT_TEST_CHECK(fit::compress_tree(sum_f(), std::string("x"))(a, std::string("b"), std::string("c")) == "xabc");
+    FIT_TEST_CHECK(fit::compress_tree(sum_f(), std::string("x"))(a, std::string("b"), std::string("c")) == 
+        fit::compress(sum_f(), std::string("x"))(a, std::string("b"), std::string("c")));
+    FIT_TEST_CHECK(a == "a");
+}
+
+struct tree_f
+{
+    std::string operator()(std::string x, std::string y) const
+    {
+        return "(" + x + y + ")";
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::compress_tree(tree_f())(std::string("1"), std::string("2"), std::string("3"), std::string("4")) == "((12)(34))");
+    FIT_TEST_CHECK(fit::compress_tree(tree_f())(std::string("1"), std::string("2"), std::string("3")) == "(1(23))");
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::compress_tree(sum_f())(
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 
+        21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40
+    ) == 820);
+}
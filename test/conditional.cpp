@@ -114,4 +114,90 @@ FIT_TEST_CASE()
     FIT_TEST_CHECK(static_fun(t3()) == 3);
 }
 #endif
+struct ref_qualified
+{
+    int operator()(t1) const&
+    {
+        return 1;
+    }
+
+    int operator()(t1) &&
+    {
+        return 2;
+    }
+};
+
+struct for_any
+{
+    template<class T>
+    constexpr int operator()(T) const
+    {
+        return 0;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto g = fit::conditional(ref_qualified(), for_any());
+    FIT_TEST_CHECK(g(t1()) == 1);
+#if FIT_HAS_RVALUE_THIS
+    FIT_TEST_CHECK(fit::conditional(ref_qualified(), for_any())(t1()) == 2);
+#endif
+}
+
+// Functions of the same type, and nested conditionals, are held separately
+FIT_TEST_CASE()
+{
+    FIT_STATIC_AUTO g = fit::conditional(f1(), fit::conditional(f1(), f2()), f2(), ff(), f3());
+    FIT_STATIC_TEST_CHECK(g(t1()) == 1);
+    FIT_STATIC_TEST_CHECK(g(t2()) == 2);
+    FIT_STATIC_TEST_CHECK(g(t3()) == 3);
+    FIT_TEST_CHECK(g(t3()) == 3);
+
+    static_assert(!fit::is_callable<decltype(fit::conditional(f1(), f2())), t3>::value, "Callable");
+    static_assert(fit::is_callable<decltype(fit::conditional(f1(), f2(), for_any())), t3>::value, "Not callable");
+
+    // The same function at the same index in the nested conditional
+    FIT_STATIC_AUTO h = fit::conditional(fit::conditional(fit::conditional(f1(), f2()), f2()), f2(), f3());
+    FIT_STATIC_TEST_CHECK(h(t1()) == 1);
+    FIT_STATIC_TEST_CHECK(h(t2()) == 2);
+    FIT_STATIC_TEST_CHECK(h(t3()) == 3);
+    FIT_TEST_CHECK(h(t3()) == 3);
+}
+
+// The first function that can be called is picked, however many there are
+template<int N>
+struct skip
+{
+    template<class T, typename std::enable_if<(T::value < N), int>::type = 0>
+    constexpr int operator()(T) const
+    {
+        return N;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_AUTO g = fit::conditional(
+        skip<1>(), skip<2>(), skip<3>(), skip<4>(), skip<5>(), skip<6>(), skip<7>(), skip<8>(), skip<9>(), skip<10>(),
+        skip<11>(), skip<12>(), skip<13>(), skip<14>(), skip<15>(), skip<16>(), skip<17>(), skip<18>(), skip<19>(), skip<20>(),
+        skip<21>(), skip<22>(), skip<23>(), skip<24>(), skip<25>(), skip<26>(), skip<27>(), skip<28>(), skip<29>(), skip<30>(),
+        skip<31>(), skip<32>(), skip<33>(), skip<34>(), skip<35>(), skip<36>(), skip<37>(), skip<38>(), skip<39>(), skip<40>()
+    );
+    FIT_STATIC_TEST_CHECK(g(std::integral_constant<int, 0>()) == 1);
+    FIT_STATIC_TEST_CHECK(g(std::integral_constant<int, 16>()) == 17);
+    FIT_STATIC_TEST_CHECK(g(std::integral_constant<int, 31>()) == 32);
+    FIT_STATIC_TEST_CHECK(g(std::integral_constant<int, 39>()) == 40);
+    FIT_TEST_CHECK(g(std::integral_constant<int, 22>()) == 23);
+    static_assert(!fit::is_callable<decltype(g), std::integral_constant<int, 40>>::value, "Callable");
+}
+
+// The functions that are not given to the constructor are default constructed
+FIT_TEST_CASE()
+{
+    fit::conditional_adaptor<f1, f2, f3> g = f1();
+    FIT_TEST_CHECK(g(t3()) == 3);
+    fit::conditional_adaptor<f1, f2, f3> h{f1(), f2()};
+    FIT_TEST_CHECK(h(t2()) == 2);
+}
 }
@@ -0,0 +1,132 @@
+#include <fit/dispatch.h>
+#include <fit/args.h>
+#include <fit/repeat.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "test.h"
+
+struct shift_left
+{
+    template<int N>
+    int operator()(std::integral_constant<int, N>, int x) const
+    {
+        return x << N;
+    }
+};
+
+struct index_of
+{
+    template<int N>
+    int operator()(std::integral_constant<int, N>) const
+    {
+        return N;
+    }
+};
+
+struct increment
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x + 1;
+    }
+};
+
+struct nth_arg
+{
+    template<class N, class... Ts>
+    auto operator()(N n, Ts... xs) const FIT_RETURNS(fit::args(n)(xs...));
+};
+
+struct add_n
+{
+    template<class N>
+    int operator()(N n, int x) const
+    {
+        return fit::repeat(n)(increment())(x);
+    }
+};
+
+struct deref_add
+{
+    template<class N>
+    int operator()(N n, std::unique_ptr<int>&& p) const
+    {
+        return *p + n;
+    }
+};
+
+struct append_b
+{
+    template<class N>
+    void operator()(N n, std::string& x) const
+    {
+        x.append(n, 'b');
+    }
+};
+
+FIT_TEST_CASE()
+{
+    for(int i = 0; i < 8; i++) FIT_TEST_CHECK(fit::dispatch<0, 7>(shift_left())(i, 1) == 1 << i);
+    FIT_TEST_CHECK(fit::dispatch<-3, 3>(index_of())(-3) == -3);
+    FIT_TEST_CHECK(fit::dispatch<-3, 3>(index_of())(0) == 0);
+    FIT_TEST_CHECK(fit::dispatch<-3, 3>(index_of())(3) == 3);
+    FIT_TEST_CHECK(fit::dispatch<5, 5>(index_of())(5) == 5);
+    FIT_TEST_CHECK(fit::dispatch<0, 255>(index_of())(200) == 200);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::dispatch<0, 7>(shift_left(), [](int n, int x) { return -n - x; });
+    FIT_TEST_CHECK(f(2, 1) == 4);
+    FIT_TEST_CHECK(f(8, 1) == -9);
+    FIT_TEST_CHECK(f(-1, 1) == 0);
+
+    auto g = fit::dispatch<1, 3>(index_of(), [](int) { return 0.5; });
+    STATIC_ASSERT_SAME(decltype(g(1)), double);
+    FIT_TEST_CHECK(g(2) == 2.0);
+    FIT_TEST_CHECK(g(4) == 0.5);
+}
+
+// Functions that take an integral constant can be used with runtime values
+FIT_TEST_CASE()
+{
+    auto nth = fit::dispatch<1, 4>(nth_arg());
+    FIT_TEST_CHECK(nth(1, 10, 20, 30, 40) == 10);
+    FIT_TEST_CHECK(nth(3, 10, 20, 30, 40) == 30);
+
+    auto add = fit::dispatch<0, 16>(add_n());
+    FIT_TEST_CHECK(add(0, 1) == 1);
+    FIT_TEST_CHECK(add(5, 1) == 6);
+    FIT_TEST_CHECK(add(16, 1) == 17);
+}
+
+// The arguments are forwarded
+FIT_TEST_CASE()
+{
+    auto take = fit::dispatch<0, 1>(deref_add());
+    FIT_TEST_CHECK(take(1, std::unique_ptr<int>(new int(2))) == 3);
+
+    std::string s = "a";
+    fit::dispatch<0, 2>(append_b())(2, s);
+    FIT_TEST_CHECK(s == "abb");
+}
+
+// Without a fallback, an integer outside of the range throws
+FIT_TEST_CASE()
+{
+    for(int n: {-1, 8, 1000})
+    {
+        bool thrown = false;
+        try
+        {
+            fit::dispatch<0, 7>(shift_left())(n, 1);
+        }
+        catch(const std::out_of_range&)
+        {
+            thrown = true;
+        }
+        FIT_TEST_CHECK(thrown);
+    }
+}
@@ -44,6 +44,24 @@ FIT_TEST_CASE()
 #endif
 }
 
+struct binomial_t
+{
+    template<class Self>
+    FIT_FIX_CONSTEXPR int operator()(Self s, int n, int k) const
+    {
+        return k == 0 || k == n ? 1 : s(n-1, k-1) + s(n-1, k);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::fix(binomial_t())(6, 3) == 20);
+#if FIT_FIX_HAS_CONSTEXPR
+    FIT_STATIC_TEST_CHECK(fit::fix(binomial_t())(6, 3) == 20);
+    FIT_STATIC_TEST_CHECK(fit::fix(factorial_t())(10) == 3628800);
+#endif
+}
+
 FIT_TEST_CASE()
 {
     const int r = factorial_move(5);
@@ -0,0 +1,168 @@
+#include <fit/fix_memo.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include "test.h"
+
+struct fib_t
+{
+    std::shared_ptr<int> calls;
+    fib_t() : calls(std::make_shared<int>(0))
+    {}
+
+    template<class Self>
+    long long operator()(Self self, int n) const
+    {
+        ++*calls;
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    }
+};
+
+struct edit_distance_t
+{
+    std::string a, b;
+
+    template<class Self>
+    int operator()(Self self, int i, int j) const
+    {
+        if (i == 0) return j;
+        if (j == 0) return i;
+        int cost = a[i-1] == b[j-1] ? 0 : 1;
+        return std::min(std::min(self(i-1, j) + 1, self(i, j-1) + 1), self(i-1, j-1) + cost);
+    }
+};
+
+struct triangular_t
+{
+    std::shared_ptr<int> calls;
+    triangular_t() : calls(std::make_shared<int>(0))
+    {}
+
+    template<class Self>
+    long long operator()(Self self, int n) const
+    {
+        ++*calls;
+        return n == 0 ? 0 : n + self(n - 1);
+    }
+};
+
+struct plain_fib_t
+{
+    template<class Self>
+    long long operator()(Self self, int n) const
+    {
+        return n < 2 ? n : self(n - 1) + self(n - 2);
+    }
+};
+
+struct string_length_t
+{
+    template<class Self>
+    std::size_t operator()(Self self, const std::string& s) const
+    {
+        return s.empty() ? 0 : 1 + self(s.substr(1));
+    }
+};
+
+template<class Policy>
+void check_fib()
+{
+    fib_t fib;
+    auto f = fit::fix_memo<long long(int), Policy>(fib);
+    FIT_TEST_CHECK(f(80) == 23416728348467685LL);
+    FIT_TEST_CHECK(*fib.calls == 81);
+    FIT_TEST_CHECK(f(80) == 23416728348467685LL);
+    FIT_TEST_CHECK(*fib.calls == 81);
+    FIT_TEST_CHECK(f(90) == 2880067194370816120LL);
+    FIT_TEST_CHECK(*fib.calls == 91);
+}
+
+FIT_TEST_CASE()
+{
+    check_fib<fit::memo_unordered_map>();
+    check_fib<fit::memo_flat_map>();
+    check_fib<fit::memo_dense<91>>();
+    check_fib<fit::memo_sharded<>>();
+    check_fib<fit::memo_sharded<1>>();
+}
+
+FIT_TEST_CASE()
+{
+    STATIC_ASSERT_SAME(fit::fix_memo_adaptor<fib_t, long long(int)>::cache_type,
+        fit::fix_memo_adaptor<fib_t, long long(int), fit::memo_unordered_map>::cache_type);
+    STATIC_ASSERT_SAME(fit::fix_memo_adaptor<fib_t, long long(const int&)>::key_type, std::tuple<int>);
+}
+
+// The copies share the cache
+FIT_TEST_CASE()
+{
+    fib_t fib;
+    auto f = fit::fix_memo<long long(int)>(fib);
+    auto g = f;
+    FIT_TEST_CHECK(f(30) == 832040);
+    FIT_TEST_CHECK(g(30) == 832040);
+    FIT_TEST_CHECK(*fib.calls == 31);
+}
+
+// Arguments outside of the bounds are computed without being cached
+FIT_TEST_CASE()
+{
+    fib_t fib;
+    auto f = fit::fix_memo<long long(int), fit::memo_dense<10>>(fib);
+    FIT_TEST_CHECK(f(9) == 34);
+    FIT_TEST_CHECK(*fib.calls == 10);
+    FIT_TEST_CHECK(f(11) == 89);
+    FIT_TEST_CHECK(*fib.calls == 12);
+    FIT_TEST_CHECK(f(11) == 89);
+    FIT_TEST_CHECK(*fib.calls == 14);
+    FIT_TEST_CHECK(f(-1) == -1);
+}
+
+template<class Policy>
+void check_edit_distance()
+{
+    auto f = fit::fix_memo<int(int, int), Policy>(edit_distance_t{"kitten", "sitting"});
+    FIT_TEST_CHECK(f(6, 7) == 3);
+    auto g = fit::fix_memo<int(int, int), Policy>(edit_distance_t{"intention", "execution"});
+    FIT_TEST_CHECK(g(9, 9) == 5);
+}
+
+FIT_TEST_CASE()
+{
+    check_edit_distance<fit::memo_unordered_map>();
+    check_edit_distance<fit::memo_flat_map>();
+    check_edit_distance<fit::memo_dense<10, 10>>();
+    check_edit_distance<fit::memo_sharded<4>>();
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::fix_memo<std::size_t(const std::string&)>(string_length_t());
+    FIT_TEST_CHECK(f("hello") == 5);
+    FIT_TEST_CHECK(f(std::string()) == 0);
+    FIT_TEST_CHECK(f.cache->map.size() == 6);
+}
+
+// Grows the flat table several times while values are being computed
+FIT_TEST_CASE()
+{
+    triangular_t triangular;
+    auto f = fit::fix_memo<long long(int), fit::memo_flat_map>(triangular);
+    for(int i = 0; i < 1000; i += 7) f(i);
+    FIT_TEST_CHECK(*triangular.calls == 995);
+    FIT_TEST_CHECK(f.cache->count == 995);
+    FIT_TEST_CHECK(f(500) == 125250);
+    FIT_TEST_CHECK(*triangular.calls == 995);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::fix_memo<long long(int), fit::memo_sharded<>>(plain_fib_t());
+    std::vector<long long> results(4);
+    std::vector<std::thread> threads;
+    for(int i = 0; i < 4; i++) threads.emplace_back([f, i, &results] { results[i] = f(60 + i); });
+    for(auto& t:threads) t.join();
+    FIT_TEST_CHECK(results[0] == 1548008755920LL);
+    FIT_TEST_CHECK(results[3] == 6557470319842LL);
+    FIT_TEST_CHECK(f(62) == 4052739537881LL);
+}
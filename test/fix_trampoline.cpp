@@ -0,0 +1,147 @@
+#include <fit/fix_trampoline.h>
+#include <memory>
+#include <string>
+#include "test.h"
+
+struct sum_to_t
+{
+    template<class Self>
+    typename Self::step operator()(Self self, int n, long long acc) const
+    {
+        if (n == 0) return acc;
+        return self(n - 1, acc + n);
+    }
+};
+
+struct sum_to_non_tail_t
+{
+    template<class Self>
+    typename Self::step operator()(Self self, int n) const
+    {
+        if (n == 0) return 0;
+        return self(n - 1).then([n](long long r) -> typename Self::step { return n + r; });
+    }
+};
+
+struct factorial_t
+{
+    template<class Self>
+    typename Self::step operator()(Self self, int n) const
+    {
+        if (n == 0) return 1;
+        return self(n - 1).then([n](int r) -> typename Self::step { return n * r; });
+    }
+};
+
+struct node
+{
+    int value;
+    std::unique_ptr<node> left;
+    std::unique_ptr<node> right;
+};
+
+// Walks both children, so every node nests a continuation in another
+struct tree_sum_t
+{
+    template<class Self>
+    typename Self::step operator()(Self self, const node* n) const
+    {
+        if (n == nullptr) return 0;
+        return self(n->left.get()).then([self, n](long long l) -> typename Self::step
+        {
+            return self(n->right.get()).then([n, l](long long r) -> typename Self::step
+            {
+                return l + r + n->value;
+            });
+        });
+    }
+};
+
+// A degenerate tree, which is a list going left or right at each node
+static std::unique_ptr<node> make_deep_tree(int depth)
+{
+    std::unique_ptr<node> root;
+    for(int i = depth; i > 0; i--)
+    {
+        std::unique_ptr<node> n(new node{i, nullptr, nullptr});
+        if (i % 2) n->left = fit::move(root);
+        else n->right = fit::move(root);
+        root = fit::move(n);
+    }
+    return root;
+}
+
+static void destroy_deep_tree(std::unique_ptr<node> root)
+{
+    while(root)
+    {
+        std::unique_ptr<node> next = root->left ? fit::move(root->left) : fit::move(root->right);
+        root = fit::move(next);
+    }
+}
+
+struct append_t
+{
+    template<class Self>
+    typename Self::step operator()(Self self, const std::string& s, int n) const
+    {
+        if (n == 0) return s;
+        return self(s + "a", n - 1);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto f = fit::fix_trampoline<long long(int, long long)>(sum_to_t());
+    FIT_TEST_CHECK(f(0, 0) == 0);
+    FIT_TEST_CHECK(f(10, 0) == 55);
+    FIT_TEST_CHECK(f(1000000, 0) == 500000500000LL);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::fix_trampoline<long long(int)>(sum_to_non_tail_t());
+    FIT_TEST_CHECK(f(0) == 0);
+    FIT_TEST_CHECK(f(10) == 55);
+    FIT_TEST_CHECK(f(1000000) == 500000500000LL);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::fix_trampoline<int(int)>(factorial_t())(5) == 5*4*3*2*1);
+}
+
+FIT_TEST_CASE()
+{
+    STATIC_ASSERT_SAME(fit::fix_trampoline_adaptor<append_t, std::string(const std::string&, int)>::step::args_type,
+        std::tuple<std::string, int>);
+    FIT_TEST_CHECK(fit::fix_trampoline<std::string(const std::string&, int)>(append_t())("b", 3) == "baaa");
+}
+
+FIT_TEST_CASE()
+{
+    std::unique_ptr<node> small(new node{1,
+        std::unique_ptr<node>(new node{2, nullptr, nullptr}),
+        std::unique_ptr<node>(new node{3, std::unique_ptr<node>(new node{4, nullptr, nullptr}), nullptr})
+    });
+    auto f = fit::fix_trampoline<long long(const node*)>(tree_sum_t());
+    FIT_TEST_CHECK(f(small.get()) == 10);
+    FIT_TEST_CHECK(f(nullptr) == 0);
+
+    std::unique_ptr<node> deep = make_deep_tree(200000);
+    FIT_TEST_CHECK(f(deep.get()) == 200000LL * 200001LL / 2);
+    destroy_deep_tree(fit::move(deep));
+}
+
+// A continuation added to a step that is already a result runs right away
+FIT_TEST_CASE()
+{
+    typedef fit::trampoline_step<int, int> step;
+    step s = step(2).then([](int x) -> step { return x * 3; });
+    FIT_TEST_CHECK(!s.is_call);
+    FIT_TEST_CHECK(s.value == 6);
+
+    step c = step::call(1).then([](int x) -> step { return x + 1; }).then([](int x) -> step { return x * 2; });
+    FIT_TEST_CHECK(c.is_call);
+    FIT_TEST_CHECK((*c.next)(3).value == 8);
+}
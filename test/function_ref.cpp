@@ -0,0 +1,109 @@
+#include <fit/function_ref.h>
+#include <fit/capture.h>
+#include <fit/compose.h>
+#include <fit/conditional.h>
+#include <fit/partial.h>
+#include <fit/placeholders.h>
+#include <memory>
+#include <string>
+#include "test.h"
+
+static_assert(sizeof(fit::function_ref<int(int)>) == 2 * sizeof(void*), "Not two words");
+static_assert(std::is_trivially_copyable<fit::function_ref<int(int)>>::value, "Not trivially copyable");
+
+static int apply_twice(fit::function_ref<int(int)> f, int x)
+{
+    return f(f(x));
+}
+
+static int times3(int x)
+{
+    return x * 3;
+}
+
+struct sum
+{
+    template<class T, class U>
+    T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+struct counter
+{
+    int n;
+    int operator()(int x)
+    {
+        return n += x;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(apply_twice([](int x) { return x + 1; }, 1) == 3);
+    FIT_TEST_CHECK(apply_twice(times3, 1) == 9);
+    FIT_TEST_CHECK(apply_twice(&times3, 2) == 18);
+    int (*p)(int) = times3;
+    fit::function_ref<int(int)> f = p;
+    p = nullptr;
+    FIT_TEST_CHECK(f(3) == 9);
+}
+
+// Fit adaptors are referred to without a copy
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(apply_twice(fit::capture(1)(sum()), 3) == 5);
+    FIT_TEST_CHECK(apply_twice(fit::partial(sum())(10), 3) == 23);
+    FIT_TEST_CHECK(apply_twice(fit::compose([](int x) { return x * 2; }, fit::_ + 1), 1) == 10);
+    FIT_TEST_CHECK(apply_twice(fit::conditional([](int x) { return x * 2; }, fit::_), 1) == 4);
+
+    std::string big(100, 'a');
+    auto f = fit::capture(big, std::string("b"))([](const std::string& x, const std::string& y, int n) { return int(x.size() + y.size()) + n; });
+    fit::function_ref<int(int)> r = f;
+    FIT_TEST_CHECK(r(1) == 102);
+}
+
+// A mutable function object is called in place
+FIT_TEST_CASE()
+{
+    counter c = { 0 };
+    fit::function_ref<int(int)> f = c;
+    f(2);
+    f(3);
+    FIT_TEST_CHECK(c.n == 5);
+    fit::function_ref<int(int)> g = f;
+    g(1);
+    FIT_TEST_CHECK(c.n == 6);
+}
+
+// The results are converted, or discarded for void. A function_ref doesn't
+// keep its target alive, so every target is a named object.
+FIT_TEST_CASE()
+{
+    sum s;
+    fit::function_ref<long(int, int)> f = s;
+    FIT_TEST_CHECK(f(1, 2) == 3L);
+    int n = 0;
+    auto set = [&n](int x) { n = x; return x; };
+    fit::function_ref<void(int)> g = set;
+    g(4);
+    FIT_TEST_CHECK(n == 4);
+
+    FIT_STATIC_TEST_CHECK(std::is_convertible<sum, fit::function_ref<int(int, int)>>::value);
+    FIT_STATIC_TEST_CHECK(!std::is_convertible<sum, fit::function_ref<int(int)>>::value);
+    FIT_STATIC_TEST_CHECK(!std::is_convertible<sum, fit::function_ref<std::string(int, int)>>::value);
+}
+
+// The arguments are forwarded
+FIT_TEST_CASE()
+{
+    auto deref = [](std::unique_ptr<int> p) { return *p; };
+    fit::function_ref<int(std::unique_ptr<int>)> f = deref;
+    FIT_TEST_CHECK(f(std::unique_ptr<int>(new int(3))) == 3);
+    std::string s;
+    auto assign = [](std::string& x) { x = "a"; };
+    fit::function_ref<void(std::string&)> g = assign;
+    g(s);
+    FIT_TEST_CHECK(s == "a");
+}
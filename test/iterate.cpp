@@ -0,0 +1,172 @@
+#include <fit/iterate.h>
+#include <fit/repeat.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include "test.h"
+
+struct twice
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x * 2;
+    }
+};
+
+struct increment
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x + 1;
+    }
+};
+
+struct less_than
+{
+    int n;
+    bool operator()(int x) const
+    {
+        return x < n;
+    }
+};
+
+struct counted_increment
+{
+    int* calls;
+    int operator()(int x) const
+    {
+        ++*calls;
+        return x + 1;
+    }
+};
+
+struct copied_state
+{
+    int* copies;
+    int n;
+
+    copied_state(int* c, int x) : copies(c), n(x)
+    {}
+
+    copied_state(const copied_state& rhs) : copies(rhs.copies), n(rhs.n)
+    {
+        ++*copies;
+    }
+
+    copied_state& operator=(const copied_state&)=default;
+};
+
+struct next_state
+{
+    copied_state operator()(const copied_state& s) const
+    {
+        return copied_state(s.copies, s.n + 1);
+    }
+};
+
+struct append_a
+{
+    std::string operator()(const std::string& s) const
+    {
+        return s + "a";
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v;
+    for(int x: fit::iterate(twice())(1).take(5)) v.push_back(x);
+    FIT_TEST_CHECK(v == std::vector<int>({1, 2, 4, 8, 16}));
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v;
+    for(int x: fit::iterate(increment())(0).take_while(less_than{4})) v.push_back(x);
+    FIT_TEST_CHECK(v == std::vector<int>({0, 1, 2, 3}));
+
+    v.clear();
+    for(int x: fit::iterate(increment())(0).take(10).take_while(less_than{4})) v.push_back(x);
+    FIT_TEST_CHECK(v == std::vector<int>({0, 1, 2, 3}));
+
+    v.clear();
+    for(int x: fit::iterate(increment())(0).take_while(less_than{4}).take(2)) v.push_back(x);
+    FIT_TEST_CHECK(v == std::vector<int>({0, 1}));
+}
+
+FIT_TEST_CASE()
+{
+    auto r = fit::iterate(twice())(1).take(0);
+    FIT_TEST_CHECK(r.begin() == r.end());
+    auto w = fit::iterate(twice())(8).take_while(less_than{4});
+    FIT_TEST_CHECK(w.begin() == w.end());
+}
+
+FIT_TEST_CASE()
+{
+    auto r = fit::iterate(twice())(1);
+    auto it = std::find_if(r.begin(), r.end(), [](int x) { return x > 1000; });
+    FIT_TEST_CHECK(*it == 1024);
+    FIT_TEST_CHECK(*std::next(r.begin(), 7) == fit::repeat(7)(twice())(1));
+
+    auto t = r.take(10);
+    FIT_TEST_CHECK(std::accumulate(t.begin(), t.end(), 0) == 1023);
+    FIT_TEST_CHECK(std::count_if(t.begin(), t.end(), [](int x) { return x > 100; }) == 3);
+    std::vector<int> v(t.begin(), t.end());
+    FIT_TEST_CHECK(v.size() == 10);
+    FIT_TEST_CHECK(v.back() == 512);
+}
+
+FIT_TEST_CASE()
+{
+    std::string s;
+    for(const std::string& x: fit::iterate(append_a())(std::string()).take(4)) s += x + ",";
+    FIT_TEST_CHECK(s == ",a,aa,aaa,");
+
+    // Copies of an iterator are advanced independently
+    auto r = fit::iterate(increment())(0);
+    auto it = r.begin();
+    auto copy = it;
+    ++it;
+    ++it;
+    FIT_TEST_CHECK(*it == 2);
+    FIT_TEST_CHECK(*copy == 0);
+    FIT_TEST_CHECK(*copy++ == 0);
+    FIT_TEST_CHECK(*copy == 1);
+}
+
+// The function is only applied for the states that are read
+FIT_TEST_CASE()
+{
+    int calls = 0;
+    int sum = 0;
+    for(int x: fit::iterate(counted_increment{&calls})(0).take(5)) sum += x;
+    FIT_TEST_CHECK(sum == 10);
+    FIT_TEST_CHECK(calls == 4);
+
+    calls = 0;
+    auto r = fit::iterate(counted_increment{&calls})(0).take(1);
+    FIT_TEST_CHECK(std::distance(r.begin(), r.end()) == 1);
+    FIT_TEST_CHECK(calls == 0);
+
+    calls = 0;
+    auto w = fit::iterate(counted_increment{&calls})(0).take_while(less_than{3});
+    FIT_TEST_CHECK(std::distance(w.begin(), w.end()) == 3);
+    FIT_TEST_CHECK(calls == 3);
+}
+
+// The end iterator doesn't hold a state, so it isn't copied to make one
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    auto r = fit::iterate(next_state())(copied_state(&copies, 0)).take(3);
+    copies = 0;
+    auto last = r.end();
+    FIT_TEST_CHECK(last == r.end());
+    FIT_TEST_CHECK(copies == 0);
+    auto it = r.begin();
+    FIT_TEST_CHECK(copies == 1);
+    FIT_TEST_CHECK(std::distance(it, last) == 3);
+}
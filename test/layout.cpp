@@ -0,0 +1,338 @@
+#include <fit/always.h>
+#include <fit/by.h>
+#include <fit/capture.h>
+#include <fit/combine.h>
+#include <fit/compose.h>
+#include <fit/compress.h>
+#include <fit/conditional.h>
+#include <fit/fix.h>
+#include <fit/flip.h>
+#include <fit/flow.h>
+#include <fit/if.h>
+#include <fit/indirect.h>
+#include <fit/infix.h>
+#include <fit/lazy.h>
+#include <fit/match.h>
+#include <fit/pack.h>
+#include <fit/partial.h>
+#include <fit/pipable.h>
+#include <fit/protect.h>
+#include <fit/result.h>
+#include <fit/reveal.h>
+#include <fit/reverse_compress.h>
+#include <fit/rotate.h>
+#include <fit/tap.h>
+#include <fit/unpack.h>
+#include "test.h"
+
+// The layout checks assert that an adaptor is empty when everything it
+// stores is empty, and that it is never larger than its non-empty members
+// laid out back to back(rounded up to their alignment).
+
+template<class T>
+struct member_size
+: std::integral_constant<std::size_t, (std::is_empty<T>::value ? 0 : sizeof(T))>
+{};
+
+template<class T>
+struct member_align
+: std::integral_constant<std::size_t, (std::is_empty<T>::value ? 1 : alignof(T))>
+{};
+
+template<class... Ts>
+struct members_size;
+
+template<>
+struct members_size<>
+: std::integral_constant<std::size_t, 0>
+{};
+
+template<class T, class... Ts>
+struct members_size<T, Ts...>
+: std::integral_constant<std::size_t, member_size<T>::value + members_size<Ts...>::value>
+{};
+
+template<class... Ts>
+struct members_align;
+
+template<>
+struct members_align<>
+: std::integral_constant<std::size_t, 1>
+{};
+
+template<class T, class... Ts>
+struct members_align<T, Ts...>
+: std::integral_constant<std::size_t, (member_align<T>::value > members_align<Ts...>::value ?
+    member_align<T>::value : members_align<Ts...>::value)>
+{};
+
+template<class Adaptor, class... Members>
+struct check_layout
+{
+    static constexpr std::size_t align = members_align<Members...>::value;
+    static constexpr std::size_t size = (members_size<Members...>::value + align - 1) / align * align;
+
+    static_assert(std::is_empty<Adaptor>::value == (size == 0), "Adaptor is not empty when all of its members are empty");
+    static_assert(sizeof(Adaptor) <= (size == 0 ? 1 : size), "Adaptor is larger than its non-empty members");
+    static_assert(alignof(Adaptor) == align, "Adaptor is overaligned");
+};
+
+template<class... Members, class Adaptor>
+check_layout<Adaptor, Members...> layout(const Adaptor&)
+{
+    return {};
+}
+
+template<int N>
+struct empty_f
+{
+    template<class T, class U>
+    constexpr int operator()(T, U) const
+    {
+        return N;
+    }
+};
+
+// Like a lambda, this is empty, but it is not default constructible
+template<int N>
+struct closure_f
+{
+    constexpr closure_f(int)
+    {}
+
+    template<class T, class U>
+    constexpr int operator()(T, U) const
+    {
+        return N;
+    }
+};
+
+template<int N>
+struct int_f
+{
+    int x;
+    constexpr int_f() : x(N)
+    {}
+
+    template<class T, class U>
+    constexpr int operator()(T, U) const
+    {
+        return x;
+    }
+};
+
+template<int N>
+struct double_f
+{
+    double x;
+    constexpr double_f() : x(N)
+    {}
+
+    template<class T, class U>
+    constexpr double operator()(T, U) const
+    {
+        return x;
+    }
+};
+
+typedef empty_f<0> e0;
+typedef empty_f<1> e1;
+typedef empty_f<2> e2;
+typedef int_f<0> i0;
+typedef int_f<1> i1;
+typedef int_f<2> i2;
+typedef double_f<0> d0;
+
+FIT_TEST_CASE()
+{
+    layout<e0, e1>(fit::pack(e0(), e1()));
+    layout<e0, e0>(fit::pack(e0(), e0()));
+    layout<i0, e1>(fit::pack(i0(), e1()));
+    layout<e0, i1>(fit::pack(e0(), i1()));
+    layout<i0, i1>(fit::pack(i0(), i1()));
+    layout<i0, d0>(fit::pack(i0(), d0()));
+    layout<e0, i1, e2>(fit::pack(e0(), i1(), e2()));
+    layout<e0, e1>(fit::pack_decay(e0(), e1()));
+    layout<int, char>(fit::pack(1, 'a'));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0, e1>(fit::capture(e0())(e1()));
+    layout<i0, e1>(fit::capture(i0())(e1()));
+    layout<e0, i1>(fit::capture(e0())(i1()));
+    layout<i0, i1>(fit::capture(i0())(i1()));
+    layout<int, int, e0>(fit::capture(1, 2)(e0()));
+    layout<int, i0>(fit::capture(1)(i0()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::partial(e0()));
+    layout<i0>(fit::partial(i0()));
+    layout<e0, int>(fit::partial(e0())(1));
+    layout<i0, int>(fit::partial(i0())(1));
+    layout<e0, e1>(fit::partial(e0())(e1()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::lazy(e0()));
+    layout<e0, int, int>(fit::lazy(e0())(1, 2));
+    layout<i0, int, int>(fit::lazy(i0())(1, 2));
+    layout<e0, int>(fit::lazy(e0())(std::placeholders::_1, 2));
+    layout<e0>(fit::lazy(e0())(std::placeholders::_1, std::placeholders::_2));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0, e1>(fit::compose(e0(), e1()));
+    layout<i0, e1>(fit::compose(i0(), e1()));
+    layout<e0, i1>(fit::compose(e0(), i1()));
+    layout<i0, i1>(fit::compose(i0(), i1()));
+    layout<e0, e1, e2>(fit::compose(e0(), e1(), e2()));
+    layout<i0, i1, i2>(fit::compose(i0(), i1(), i2()));
+    layout<e0, i1, e2>(fit::compose(e0(), i1(), e2()));
+    layout<i0, d0>(fit::compose(i0(), d0()));
+
+    layout<e0, e1>(fit::flow(e0(), e1()));
+    layout<i0, i1>(fit::flow(i0(), i1()));
+    layout<e0, i1, e2>(fit::flow(e0(), i1(), e2()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::by(e0()));
+    layout<i0>(fit::by(i0()));
+    layout<e0, e1>(fit::by(e0(), e1()));
+    layout<i0, e1>(fit::by(i0(), e1()));
+    layout<e0, i1>(fit::by(e0(), i1()));
+    layout<i0, i1>(fit::by(i0(), i1()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0, e1>(fit::conditional(e0(), e1()));
+    layout<i0, e1>(fit::conditional(i0(), e1()));
+    layout<i0, i1>(fit::conditional(i0(), i1()));
+    layout<e0, i1, e2>(fit::conditional(e0(), i1(), e2()));
+
+    layout<e0, e1>(fit::match(e0(), e1()));
+    layout<i0, i1>(fit::match(i0(), i1()));
+    layout<e0, i1, e2>(fit::match(e0(), i1(), e2()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0, e1, e2>(fit::combine(e0(), e1(), e2()));
+    layout<i0, i1, i2>(fit::combine(i0(), i1(), i2()));
+    layout<i0, e1, i2>(fit::combine(i0(), e1(), i2()));
+    layout<e0, i1, e2>(fit::combine(e0(), i1(), e2()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::compress(e0()));
+    layout<i0>(fit::compress(i0()));
+    layout<e0, int>(fit::compress(e0(), 0));
+    layout<i0, int>(fit::compress(i0(), 0));
+    layout<e0, int>(fit::reverse_compress(e0(), 0));
+    layout<i0, int>(fit::reverse_compress(i0(), 0));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::fix(e0()));
+    layout<i0>(fit::fix(i0()));
+    layout<e0>(fit::flip(e0()));
+    layout<i0>(fit::flip(i0()));
+    layout<e0>(fit::rotate(e0()));
+    layout<i0>(fit::rotate(i0()));
+    layout<e0>(fit::infix(e0()));
+    layout<i0>(fit::infix(i0()));
+    layout<e0>(fit::protect(e0()));
+    layout<i0>(fit::protect(i0()));
+    layout<e0>(fit::reveal(e0()));
+    layout<i0>(fit::reveal(i0()));
+    layout<e0>(fit::result<int>(e0()));
+    layout<i0>(fit::result<int>(i0()));
+    layout<e0>(fit::unpack(e0()));
+    layout<i0>(fit::unpack(i0()));
+    layout<std::shared_ptr<i0>>(fit::indirect(std::make_shared<i0>()));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::pipable(e0()));
+    layout<i0>(fit::pipable(i0()));
+    // The pipe closure holds its arguments by reference
+    layout<e0, const int*>(fit::pipable(e0())(1));
+    layout<i0, const int*>(fit::pipable(i0())(1));
+}
+
+FIT_TEST_CASE()
+{
+    int n = 0;
+    layout<>(fit::always());
+    layout<int>(fit::always(1));
+    layout<e0>(fit::always(e0()));
+    layout<i0>(fit::always(i0()));
+    layout<int*>(fit::always_ref(n));
+}
+
+FIT_TEST_CASE()
+{
+    layout<e0>(fit::if_(std::true_type())(e0()));
+    layout<i0>(fit::if_(std::true_type())(i0()));
+    layout<>(fit::if_(std::false_type())(e0()));
+    layout<>(fit::if_(std::false_type())(i0()));
+}
+
+FIT_TEST_CASE()
+{
+    e0 e;
+    i0 i;
+    layout<>(fit::tap);
+    // Like pipable, the closure holds the function by reference
+    layout<const e0*>(fit::tap(e));
+    layout<const i0*>(fit::tap(i));
+}
+
+#if FIT_PACK_HAS_EBO
+FIT_TEST_CASE()
+{
+    typedef closure_f<0> c0;
+    typedef closure_f<1> c1;
+    layout<c0, c1>(fit::pack(c0(0), c1(0)));
+    layout<c0, int>(fit::pack(c0(0), 1));
+    layout<c0, c1>(fit::capture(c0(0))(c1(0)));
+    layout<c0, int>(fit::capture(1)(c0(0)));
+    layout<c0, int>(fit::lazy(c0(0))(1, std::placeholders::_1));
+    layout<c0, c1>(fit::combine(c0(0), c1(0)));
+}
+
+// Two objects of the same type must have distinct addresses, so an empty
+// type that is packed more than once can't share storage with itself. Each
+// repeat takes a byte instead, which is the exception to the layout bound.
+FIT_TEST_CASE()
+{
+    typedef closure_f<0> c0;
+    typedef closure_f<1> c1;
+    static_assert(sizeof(decltype(fit::pack(c0(0), c0(0)))) <= 2, "Pack of a repeated empty type is too large");
+    static_assert(sizeof(decltype(fit::pack(c0(0), c0(0), c0(0)))) <= 3, "Pack of a repeated empty type is too large");
+    static_assert(sizeof(decltype(fit::pack(c0(0), c1(0), c0(0)))) <= 2, "Pack of a repeated empty type is too large");
+    FIT_TEST_CHECK(fit::pack(c0(0), c0(0))(fit::always(1)) == 1);
+}
+#endif
+
+FIT_TEST_CASE()
+{
+    typedef closure_f<0> c0;
+    typedef closure_f<1> c1;
+    layout<c0, c1>(fit::compose(c0(0), c1(0)));
+    layout<c0, c1>(fit::conditional(c0(0), c1(0)));
+    layout<c0, c1>(fit::match(c0(0), c1(0)));
+    layout<c0, int>(fit::compress(c0(0), 0));
+    layout<c0>(fit::always(c0(0)));
+    layout<c0>(fit::if_(std::true_type())(c0(0)));
+}
@@ -163,3 +163,18 @@ FIT_TEST_CASE()
 {
     FIT_TEST_CHECK(fit::lazy(deref())(std::unique_ptr<int>(new int(3)))() == 3);
 }
+
+#if FIT_HAS_RVALUE_THIS
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto f = fit::lazy(by_value_class())(copy_counter(&copies, &moves), std::placeholders::_1);
+    copies = 0;
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(copies == 1);
+    copies = 0;
+    FIT_TEST_CHECK(std::move(f)(1) == 2);
+    FIT_TEST_CHECK(copies == 0);
+}
+#endif
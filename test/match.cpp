@@ -157,3 +157,88 @@ FIT_TEST_CASE()
 };
 
 
+
+template<int N>
+struct tag
+{};
+
+template<int N>
+struct tag_class
+{
+    int value;
+    constexpr tag_class(int x=N) : value(x)
+    {}
+
+    constexpr int operator()(tag<N>) const
+    {
+        return value;
+    }
+};
+
+// Enough functions to go through several groups of inherited overloads
+FIT_TEST_CASE()
+{
+    FIT_STATIC_AUTO f = fit::match(
+        tag_class<0>(), tag_class<1>(), tag_class<2>(), tag_class<3>(), tag_class<4>(), tag_class<5>(), tag_class<6>(), 
+        tag_class<7>(), tag_class<8>(), tag_class<9>(), tag_class<10>(), tag_class<11>(), tag_class<12>(), tag_class<13>(), 
+        tag_class<14>(), tag_class<15>(), tag_class<16>(), tag_class<17>(), tag_class<18>(), tag_class<19>(), int_class()
+    );
+    FIT_STATIC_TEST_CHECK(f(tag<0>()) == 0);
+    FIT_STATIC_TEST_CHECK(f(tag<7>()) == 7);
+    FIT_STATIC_TEST_CHECK(f(tag<8>()) == 8);
+    FIT_STATIC_TEST_CHECK(f(tag<19>()) == 19);
+    FIT_STATIC_TEST_CHECK(f(3) == 1);
+    FIT_TEST_CHECK(f(tag<12>()) == 12);
+    static_assert(!fit::is_callable<decltype(f), tag<20>>::value, "Callable");
+}
+
+// The functions that are not given to the constructor are default constructed
+FIT_TEST_CASE()
+{
+    fit::match_adaptor<tag_class<0>, tag_class<1>, tag_class<2>> f{tag_class<0>(10), tag_class<1>(11)};
+    FIT_TEST_CHECK(f(tag<0>()) == 10);
+    FIT_TEST_CHECK(f(tag<1>()) == 11);
+    FIT_TEST_CHECK(f(tag<2>()) == 2);
+}
+
+struct no_default_class
+{
+    constexpr no_default_class(int)
+    {}
+
+    constexpr int operator()(foo) const
+    {
+        return 2;
+    }
+};
+
+// Default construction is checked on the leaves in every group of overloads
+FIT_TEST_CASE()
+{
+    typedef fit::match_adaptor<
+        tag_class<0>, tag_class<1>, tag_class<2>, tag_class<3>, tag_class<4>, 
+        tag_class<5>, tag_class<6>, tag_class<7>, tag_class<8>, tag_class<9>
+    > all_default;
+    constexpr all_default f = {};
+    FIT_STATIC_TEST_CHECK(f(tag<3>()) == 3);
+    FIT_STATIC_TEST_CHECK(f(tag<9>()) == 9);
+
+    typedef fit::match_adaptor<
+        tag_class<0>, no_default_class, tag_class<2>, tag_class<3>, tag_class<4>, 
+        tag_class<5>, tag_class<6>, tag_class<7>, tag_class<8>, tag_class<9>
+    > first_group;
+    typedef fit::match_adaptor<
+        tag_class<0>, tag_class<1>, tag_class<2>, tag_class<3>, tag_class<4>, 
+        tag_class<5>, tag_class<6>, tag_class<7>, tag_class<8>, no_default_class
+    > last_group;
+    STATIC_ASSERT_NOT_DEFAULT_CONSTRUCTIBLE(first_group);
+    STATIC_ASSERT_NOT_DEFAULT_CONSTRUCTIBLE(last_group);
+}
+
+// The same type can be used for several functions
+FIT_TEST_CASE()
+{
+    auto f = fit::match(foo_class(), int_class(), foo_class());
+    static_assert(!fit::is_callable<decltype(f), foo>::value, "Not ambiguous");
+    FIT_TEST_CHECK(f(1) == 1);
+}
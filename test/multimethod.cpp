@@ -0,0 +1,225 @@
+#include <fit/multimethod.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "test.h"
+
+struct shape
+{
+    virtual ~shape()
+    {}
+};
+
+struct circle : shape
+{};
+
+struct square : shape
+{};
+
+struct rounded_square : square
+{};
+
+// Not a shape, so the base is at an offset in the derived class
+struct named
+{
+    std::string name;
+    virtual ~named()
+    {}
+};
+
+struct named_circle : named, circle
+{
+    int id;
+    named_circle(int x) : id(x)
+    {}
+};
+
+int circle_id(const circle& c)
+{
+    const named_circle* n = dynamic_cast<const named_circle*>(&c);
+    return n ? n->id : 0;
+}
+
+FIT_TEST_CASE()
+{
+    auto name = fit::multimethod<const shape>(
+        [](const circle&) { return std::string("circle"); },
+        [](const square&) { return std::string("square"); },
+        [](const rounded_square&) { return std::string("rounded_square"); },
+        [](const shape&) { return std::string("shape"); }
+    );
+    circle c;
+    square s;
+    rounded_square r;
+    shape x;
+    const shape& cr = c;
+    const shape& sr = s;
+    const shape& rr = r;
+    FIT_TEST_CHECK(name(cr) == "circle");
+    FIT_TEST_CHECK(name(sr) == "square");
+    FIT_TEST_CHECK(name(rr) == "rounded_square");
+    FIT_TEST_CHECK(name(x) == "shape");
+    // Again, from the cache
+    FIT_TEST_CHECK(name(cr) == "circle");
+    FIT_TEST_CHECK(name(rr) == "rounded_square");
+    FIT_TEST_CHECK(name(sr) == "square");
+    FIT_TEST_CHECK(name(&rr) == "rounded_square");
+}
+
+// The most derived overload is chosen, whatever the order of the overloads
+FIT_TEST_CASE()
+{
+    auto collide = fit::multimethod<const shape>(
+        [](const shape&, const shape&) { return 0; },
+        [](const square&, const shape&) { return 1; },
+        [](const shape&, const circle&) { return 2; },
+        [](const square&, const circle&) { return 3; },
+        [](const rounded_square&, const rounded_square&) { return 4; }
+    );
+    circle c;
+    square s;
+    rounded_square r;
+    for(int i = 0; i < 2; i++)
+    {
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(c), static_cast<const shape&>(c)) == 2);
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(s), static_cast<const shape&>(s)) == 1);
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(s), static_cast<const shape&>(c)) == 3);
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(r), static_cast<const shape&>(c)) == 3);
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(c), static_cast<const shape&>(s)) == 0);
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(r), static_cast<const shape&>(r)) == 4);
+        FIT_TEST_CHECK(collide(static_cast<const shape&>(r), static_cast<const shape&>(s)) == 1);
+    }
+}
+
+template<class F>
+static bool throws_ambiguous(F f, const shape& x, const shape& y)
+{
+    try
+    {
+        f(x, y);
+    }
+    catch(const fit::ambiguous_multimethod&)
+    {
+        return true;
+    }
+    return false;
+}
+
+// When no overload dominates the others, the call is ambiguous, whatever the
+// order of the overloads, and the fallback is not used
+FIT_TEST_CASE()
+{
+    auto f = fit::multimethod<const shape>(
+        [](const shape&, const shape&) { return 0; },
+        [](const circle&, const shape&) { return 1; },
+        [](const shape&, const square&) { return 2; }
+    );
+    auto g = fit::multimethod<const shape>(
+        [](const shape&, const square&) { return 2; },
+        [](const circle&, const shape&) { return 1; },
+        [](const shape&, const shape&) { return 0; }
+    );
+    circle c;
+    square s;
+    for(int i = 0; i < 2; i++)
+    {
+        FIT_TEST_CHECK(throws_ambiguous(f, c, s));
+        FIT_TEST_CHECK(throws_ambiguous(g, c, s));
+        FIT_TEST_CHECK(f(c, c) == 1 && g(c, c) == 1);
+        FIT_TEST_CHECK(f(s, s) == 2 && g(s, s) == 2);
+        FIT_TEST_CHECK(f(s, c) == 0 && g(s, c) == 0);
+    }
+
+    // An overload that dominates both resolves it
+    auto h = fit::multimethod<const shape>(
+        [](const shape&, const shape&) { return 0; },
+        [](const circle&, const shape&) { return 1; },
+        [](const shape&, const square&) { return 2; },
+        [](const circle&, const square&) { return 3; }
+    );
+    FIT_TEST_CHECK(h(static_cast<const shape&>(c), static_cast<const shape&>(s)) == 3);
+}
+
+// An ambiguous call is also a bad_cast, like a call that matches nothing
+FIT_TEST_CASE()
+{
+    auto f = fit::multimethod<const shape>(
+        [](const square&, const shape&) { return 1; },
+        [](const shape&, const square&) { return 2; }
+    );
+    square s;
+    circle c;
+    FIT_TEST_CHECK(f(static_cast<const shape&>(s), static_cast<const shape&>(c)) == 1);
+    FIT_TEST_CHECK(f(static_cast<const shape&>(c), static_cast<const shape&>(s)) == 2);
+    int thrown = 0;
+    for(const shape* x: {static_cast<const shape*>(&s), static_cast<const shape*>(&c)})
+    {
+        try
+        {
+            f(*x, *x);
+        }
+        catch(const std::bad_cast&)
+        {
+            thrown++;
+        }
+    }
+    FIT_TEST_CHECK(thrown == 2);
+}
+
+// The arguments are adjusted when the base is not at the start of the object
+FIT_TEST_CASE()
+{
+    auto id = fit::multimethod<shape>(
+        [](circle& c) { return circle_id(c); },
+        [](shape*) { return -1; }
+    );
+    named_circle n1(7);
+    named_circle n2(9);
+    square s;
+    FIT_TEST_CHECK(id(static_cast<shape&>(n1)) == 7);
+    FIT_TEST_CHECK(id(static_cast<shape&>(n2)) == 9);
+    FIT_TEST_CHECK(id(static_cast<shape*>(&n1)) == 7);
+    FIT_TEST_CHECK(id(static_cast<shape&>(s)) == -1);
+}
+
+// Function pointers, results converted to their common type, and copies that
+// share the cache
+static int circle_to_int(const circle&)
+{
+    return 1;
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::multimethod<const shape>(&circle_to_int, [](const square&) { return 2.5; });
+    STATIC_ASSERT_SAME(decltype(f(std::declval<const shape&>())), double);
+    circle c;
+    square s;
+    FIT_TEST_CHECK(f(static_cast<const shape&>(c)) == 1.0);
+    auto g = f;
+    FIT_TEST_CHECK(g.cache == f.cache);
+    FIT_TEST_CHECK(g(static_cast<const shape&>(s)) == 2.5);
+}
+
+// With a sharded cache, it can be called from several threads
+FIT_TEST_CASE()
+{
+    auto f = fit::multimethod<const shape, fit::memo_sharded<>>(
+        [](const circle&, const circle&) { return 1; },
+        [](const shape&, const shape&) { return 0; }
+    );
+    circle c;
+    square s;
+    std::vector<int> results(4, 0);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++) threads.emplace_back([&, t]
+    {
+        for(int i = 0; i < 1000; i++)
+        {
+            results[t] += f(static_cast<const shape&>(c), static_cast<const shape&>(c));
+            results[t] += f(static_cast<const shape&>(c), static_cast<const shape&>(s));
+        }
+    });
+    for(auto& t:threads) t.join();
+    for(int r:results) FIT_TEST_CHECK(r == 1000);
+}
@@ -2,6 +2,7 @@
 #include <fit/always.h>
 #include <fit/identity.h>
 #include <memory>
+#include <string>
 #include "test.h"
 
 FIT_TEST_CASE()
@@ -303,4 +304,146 @@ FIT_TEST_CASE()
     FIT_STATIC_TEST_CHECK(fit::pack(not_default_constructible(1), not_default_constructible(1), not_default_constructible(1))(select_i()) == 3);
 }
 
+// An empty final type can't be inherited, so it is held as a member
+struct final_empty final
+{
+    constexpr final_empty(int)
+    {}
+};
+
+struct count_args
+{
+    template<class... Ts>
+    constexpr int operator()(Ts&&...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto p = fit::pack(final_empty(0), 1);
+    FIT_TEST_CHECK(p(count_args()) == 2);
+    FIT_STATIC_TEST_CHECK(fit::pack(final_empty(0), 1)(count_args()) == 2);
+    FIT_TEST_CHECK(fit::pack(final_empty(0), final_empty(0))(count_args()) == 2);
+    FIT_TEST_CHECK(fit::pack_join(p, fit::pack(final_empty(0)))(count_args()) == 3);
+}
+
+
+FIT_TEST_CASE()
+{
+    STATIC_ASSERT_SAME(fit::detail::gens<0>::type, fit::detail::seq<>);
+    STATIC_ASSERT_SAME(fit::detail::gens<1>::type, fit::detail::seq<0>);
+    STATIC_ASSERT_SAME(fit::detail::gens<2>::type, fit::detail::seq<0, 1>);
+    STATIC_ASSERT_SAME(fit::detail::gens<5>::type, fit::detail::seq<0, 1, 2, 3, 4>);
+    STATIC_ASSERT_SAME(fit::detail::gens<8>::type, fit::detail::seq<0, 1, 2, 3, 4, 5, 6, 7>);
+}
+
+
+struct sum_all
+{
+    constexpr int operator()() const
+    {
+        return 0;
+    }
+
+    template<class T, class... Ts>
+    constexpr int operator()(T x, Ts... xs) const
+    {
+        return x + sum_all()(xs...);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    static constexpr auto p = fit::pack(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20);
+    FIT_TEST_CHECK(p(sum_all()) == 210);
+    FIT_STATIC_TEST_CHECK(p(sum_all()) == 210);
+    FIT_TEST_CHECK(fit::pack_join(p, fit::pack(1), p)(sum_all()) == 421);
+}
+
+// Elements are tagged by their index only, so an empty element that holds a
+// pack of its own must not be inherited alongside the outer pack's elements
+struct empty_closure
+{
+    constexpr empty_closure(int)
+    {}
+
+    constexpr int operator()(int x) const
+    {
+        return x;
+    }
+};
 
+FIT_TEST_CASE()
+{
+    auto inner = fit::pack(empty_closure(0));
+    auto p = fit::pack(inner, empty_closure(0));
+    FIT_TEST_CHECK(p(fit::always(3)) == 3);
+    FIT_TEST_CHECK(fit::pack(1, inner)(fit::always(2)) == 2);
+    FIT_TEST_CHECK(fit::pack(inner, inner, inner)(fit::always(1)) == 1);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto p = fit::pack(copy_counter(&copies, &moves));
+    copies = 0;
+    moves = 0;
+    auto j = fit::pack_join(p, p, p, p);
+    FIT_TEST_CHECK(copies == 4);
+    FIT_TEST_CHECK(moves == 0);
+    copies = 0;
+    auto k = fit::pack_join(std::move(p), fit::pack(1), std::move(j));
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(moves == 5);
+    FIT_TEST_CHECK(k(fit::always(1)) == 1);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(fit::pack_join(fit::pack(1, 2), fit::pack(3), fit::pack(), fit::pack(4, 5))(sum_all()) == 15);
+    FIT_TEST_CHECK(fit::pack_join(fit::pack(1, 2), fit::pack(3), fit::pack(), fit::pack(4, 5))(sum_all()) == 15);
+    FIT_TEST_CHECK(fit::pack_join(fit::pack(), fit::pack())(fit::always(0)) == 0);
+    FIT_TEST_CHECK(fit::pack_join(
+        fit::pack(std::unique_ptr<int>(new int(1))), 
+        fit::pack(), 
+        fit::pack(std::unique_ptr<int>(new int(2))),
+        fit::pack(std::unique_ptr<int>(new int(3)))
+    )(fit::always(3)) == 3);
+    int i = 1;
+    auto p = fit::pack_forward(i);
+    auto j = fit::pack_join(p, fit::pack_forward(i), p);
+    STATIC_ASSERT_SAME(decltype(j), fit::detail::pack_base<fit::detail::seq<0, 1, 2>, int&, int&, int&>);
+}
+
+struct string_size
+{
+    std::size_t operator()(std::string s) const
+    {
+        return s.size();
+    }
+};
+
+#if FIT_HAS_RVALUE_THIS
+FIT_TEST_CASE()
+{
+    const auto p = fit::pack(std::string("abc"));
+    FIT_TEST_CHECK(p(string_size()) == 3);
+    FIT_TEST_CHECK(p(string_size()) == 3);
+
+    int copies = 0;
+    int moves = 0;
+    auto q = fit::pack(copy_counter(&copies, &moves), 1);
+    copies = 0;
+    moves = 0;
+    FIT_TEST_CHECK(q(by_value_class()) == 2);
+    FIT_TEST_CHECK(copies == 1);
+    FIT_TEST_CHECK(moves == 0);
+    copies = 0;
+    FIT_TEST_CHECK(std::move(q)(by_value_class()) == 2);
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(moves == 1);
+}
+#endif
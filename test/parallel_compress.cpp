@@ -0,0 +1,95 @@
+#include <fit/parallel_compress.h>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <list>
+#include "test.h"
+
+static_assert(!std::is_convertible<std::size_t, fit::parallel_policy>::value, "The policy is implicitly constructed from a size");
+
+struct sum_f
+{
+    template<class T, class U>
+    T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+// Every chunk has more than one element in the test, so every chunk throws,
+// no matter where the chunks start
+struct throw_f
+{
+    int operator()(int, int) const
+    {
+        throw std::runtime_error("throw_f");
+    }
+};
+
+static std::vector<int> iota_vector(int n)
+{
+    std::vector<int> v(n);
+    std::iota(v.begin(), v.end(), 1);
+    return v;
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v = iota_vector(100);
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 0)(v) == 5050);
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 0)(v.begin(), v.end()) == 5050);
+    for(std::size_t n = 1; n < 8; n++)
+    {
+        FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 0)(v, fit::parallel_policy(n)) == 5050);
+        FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 10)(v.begin(), v.end(), fit::parallel_policy(n)) == 5060);
+    }
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v;
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 3)(v, fit::parallel_policy(4)) == 3);
+    v.push_back(1);
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 3)(v, fit::parallel_policy(4)) == 4);
+    v.push_back(2);
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 3)(v, fit::parallel_policy(4)) == 6);
+}
+
+FIT_TEST_CASE()
+{
+    int a[] = { 1, 2, 3, 4, 5 };
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 0)(a, fit::parallel_policy(2)) == 15);
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 0)(a, a + 3, fit::parallel_policy(2)) == 6);
+    std::list<int> l(a, a + 5);
+    FIT_TEST_CHECK(fit::parallel_compress(sum_f(), 0)(l, fit::parallel_policy(3)) == 15);
+}
+
+// String concatenation is associative but not commutative
+FIT_TEST_CASE()
+{
+    std::vector<std::string> v;
+    for(char c = 'a'; c <= 'z'; c++) v.push_back(std::string(1, c));
+    std::string expected = std::accumulate(v.begin(), v.end(), std::string(">"), sum_f());
+    for(std::size_t n = 1; n < 8; n++)
+    {
+        FIT_TEST_CHECK(fit::parallel_compress(sum_f(), std::string(">"))(v, fit::parallel_policy(n).ordered()) == expected);
+    }
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v = iota_vector(20);
+    for(std::size_t n = 1; n < 10; n++)
+    {
+        bool thrown = false;
+        try
+        {
+            fit::parallel_compress(throw_f(), 0)(v, fit::parallel_policy(n));
+        }
+        catch(const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        FIT_TEST_CHECK(thrown);
+    }
+}
@@ -64,4 +64,18 @@ FIT_TEST_CASE()
     FIT_STATIC_TEST_CHECK(3 == mono_partial_constexpr(2));
     FIT_STATIC_TEST_CHECK(3 == mono_partial_constexpr()(2));
 
-}
\ No newline at end of file
+}
+#if FIT_HAS_RVALUE_THIS
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto f = fit::partial(by_value_class())(copy_counter(&copies, &moves));
+    copies = 0;
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(copies == 1);
+    copies = 0;
+    FIT_TEST_CHECK(std::move(f)(1) == 2);
+    FIT_TEST_CHECK(copies == 0);
+}
+#endif
@@ -61,3 +61,19 @@ FIT_TEST_CASE()
     FIT_STATIC_TEST_CHECK(3 == (unary_pipable_constexpr(3)));
 }
 
+
+#if FIT_HAS_RVALUE_THIS
+struct rvalue_binary_class
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) &&
+    {
+        return x+y;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(3 == (1 | fit::pipable(rvalue_binary_class())(2)));
+}
+#endif
@@ -1,4 +1,5 @@
 #include <fit/repeat.h>
+#include <string>
 #include "test.h"
 
 
@@ -11,8 +12,94 @@ struct increment
     }
 };
 
+struct increment_constant
+{
+    template<class T>
+    constexpr std::integral_constant<int, T::value + 1> operator()(T) const
+    {
+        return {};
+    }
+};
+
+struct sum_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x + 1;
+    }
+};
+
 FIT_TEST_CASE()
 {
     FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 5>())(increment())(1) == 6);
     FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 5>())(increment())(1) == 6);
 }
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 0>())(increment())(1) == 1);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 1>())(increment())(1) == 2);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 1000>())(increment())(1) == 1001);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 10000>())(increment())(1) == 10001);
+
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 0>())(increment())(1) == 1);
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 1>())(increment())(1) == 2);
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 1000>())(increment())(1) == 1001);
+}
+
+FIT_TEST_CASE()
+{
+    // The first call takes all of the arguments
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 3>())(sum_f())(1, 2) == 5);
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 3>())(sum_f())(1, 2) == 5);
+
+    STATIC_ASSERT_SAME(
+        decltype(fit::repeat(std::integral_constant<int, 13>())(increment_constant())(std::integral_constant<int, 0>())), 
+        std::integral_constant<int, 13>
+    );
+}
+
+struct append_size
+{
+    std::string operator()(std::string s) const
+    {
+        return s + char('0' + s.size());
+    }
+};
+
+FIT_TEST_CASE()
+{
+    int n = 5;
+    FIT_TEST_CHECK(fit::repeat(n)(increment())(1) == 6);
+    FIT_TEST_CHECK(fit::repeat(5)(increment())(1) == 6);
+    FIT_TEST_CHECK(fit::repeat(0)(increment())(1) == 1);
+    FIT_TEST_CHECK(fit::repeat(-3)(increment())(1) == 1);
+    FIT_TEST_CHECK(fit::repeat(std::size_t(1000))(increment())(0) == 1000);
+    STATIC_ASSERT_SAME(decltype(fit::repeat(n)(increment())(1)), int);
+}
+
+FIT_TEST_CASE()
+{
+    for(int n = -1; n < 20; n++)
+    {
+        int expected = n > 0 ? n : 0;
+        FIT_TEST_CHECK(fit::repeat(fit::unroll<1>(n))(increment())(0) == expected);
+        FIT_TEST_CHECK(fit::repeat(fit::unroll<4>(n))(increment())(0) == expected);
+        FIT_TEST_CHECK(fit::repeat(fit::unroll<7>(n))(increment())(0) == expected);
+    }
+}
+
+FIT_TEST_CASE()
+{
+    std::string s = "a";
+    FIT_TEST_CHECK(fit::repeat(3)(append_size())(s) == "a123");
+    FIT_TEST_CHECK(fit::repeat(fit::unroll<2>(5))(append_size())(s) == "a12345");
+    FIT_TEST_CHECK(s == "a");
+}
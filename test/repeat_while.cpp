@@ -36,3 +36,100 @@ FIT_TEST_CASE()
     std::integral_constant<int, 6> x = fit::repeat_while(not_6())(increment())(std::integral_constant<int, 1>());
     fit::test::unused(x);
 }
+
+struct increment_int
+{
+    int* calls;
+    int operator()(int x) const
+    {
+        ++*calls;
+        return x + 1;
+    }
+};
+
+struct less_than
+{
+    int n;
+    bool operator()(int x) const
+    {
+        return x < n;
+    }
+};
+
+// Newton's method for the square root of 2
+struct newton_step
+{
+    double operator()(double x) const
+    {
+        return (x + 2.0 / x) / 2.0;
+    }
+};
+
+struct not_converged
+{
+    bool operator()(double x) const
+    {
+        return x * x - 2.0 > 1e-12 || 2.0 - x * x > 1e-12;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    int calls = 0;
+    FIT_TEST_CHECK(fit::repeat_while(less_than{6})(increment_int{&calls})(1) == 6);
+    FIT_TEST_CHECK(calls == 5);
+    FIT_TEST_CHECK(fit::repeat_while(less_than{6})(increment_int{&calls})(6) == 6);
+    FIT_TEST_CHECK(fit::repeat_while(less_than{6})(increment_int{&calls})(10) == 10);
+    FIT_TEST_CHECK(calls == 5);
+    STATIC_ASSERT_SAME(decltype(fit::repeat_while(less_than{6})(increment_int{&calls})(1)), int);
+}
+
+FIT_TEST_CASE()
+{
+    for(int start = 0; start < 30; start++)
+    {
+        int calls = 0;
+        int expected = start < 20 ? 20 : start;
+        int expected_calls = expected - start;
+        FIT_TEST_CHECK(fit::repeat_while(fit::limit<100>(less_than{20}))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(fit::repeat_while(fit::unroll<4>(less_than{20}))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(fit::repeat_while(fit::limit<100>(fit::unroll<3>(less_than{20})))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(calls == 3 * expected_calls);
+    }
+}
+
+FIT_TEST_CASE()
+{
+    for(int start = 0; start < 30; start++)
+    {
+        int calls = 0;
+        int expected = start + 7 < 20 ? start + 7 : (start < 20 ? 20 : start);
+        FIT_TEST_CHECK(fit::repeat_while(fit::limit<7>(less_than{20}))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(fit::repeat_while(fit::limit<7>(fit::unroll<2>(less_than{20})))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(fit::repeat_while(fit::limit<7>(fit::unroll<8>(less_than{20})))(increment_int{&calls})(start) == expected);
+        // The limit can be given inside of the unroll as well
+        FIT_TEST_CHECK(fit::repeat_while(fit::unroll<2>(fit::limit<7>(less_than{20})))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(calls == 4 * (expected - start));
+    }
+    int calls = 0;
+    FIT_TEST_CHECK(fit::repeat_while(fit::limit<0>(less_than{20}))(increment_int{&calls})(0) == 0);
+    FIT_TEST_CHECK(calls == 0);
+}
+
+FIT_TEST_CASE()
+{
+    for(int start = 0; start < 30; start++)
+    {
+        int calls = 0;
+        int expected = start + 10 < 20 ? start + 10 : (start < 20 ? 20 : start);
+        FIT_TEST_CHECK(fit::repeat_while(fit::unroll<4>(fit::limit<10>(less_than{20})))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(fit::repeat_while(fit::limit<10>(fit::unroll<4>(less_than{20})))(increment_int{&calls})(start) == expected);
+        FIT_TEST_CHECK(calls == 2 * (expected - start));
+    }
+}
+
+FIT_TEST_CASE()
+{
+    double x = fit::repeat_while(fit::limit<50>(not_converged()))(newton_step())(1.0);
+    FIT_TEST_CHECK(!not_converged()(x));
+}
@@ -0,0 +1,191 @@
+#include <fit/string_switch.h>
+#include "test.h"
+
+#if FIT_HAS_STRING_SWITCH
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+template<int N>
+struct key_index
+{
+    constexpr int operator()() const
+    {
+        return N;
+    }
+};
+
+struct unknown
+{
+    template<class S>
+    constexpr int operator()(const S&) const
+    {
+        return -1;
+    }
+};
+
+struct zero
+{
+    constexpr int operator()(const char*, int, int) const
+    {
+        return 0;
+    }
+};
+
+struct binary_op
+{
+    char op;
+
+    constexpr int operator()(int x, int y) const
+    {
+        return op == '+' ? x + y : x - y;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto calc = fit::string_switch(
+        fit::string_case("add", [](int x, int y) { return x + y; }),
+        fit::string_case("sub", [](int x, int y) { return x - y; }),
+        fit::string_case("mul", [](int x, int y) { return x * y; }),
+        [](const std::string& s, int, int) { return -int(s.size()); }
+    );
+    FIT_TEST_CHECK(calc(std::string("add"), 3, 2) == 5);
+    FIT_TEST_CHECK(calc(std::string("sub"), 3, 2) == 1);
+    FIT_TEST_CHECK(calc(std::string("mul"), 3, 2) == 6);
+    FIT_TEST_CHECK(calc(std::string("div"), 3, 2) == -3);
+    FIT_TEST_CHECK(calc(std::string("ad"), 3, 2) == -2);
+    FIT_TEST_CHECK(calc(std::string("addd"), 3, 2) == -4);
+    FIT_TEST_CHECK(calc(std::string(""), 3, 2) == 0);
+}
+
+// The table is built at compile time
+FIT_TEST_CASE()
+{
+    static constexpr auto f = fit::string_switch(
+        fit::string_case("plus", binary_op{'+'}),
+        fit::string_case("minus", binary_op{'-'}),
+        zero()
+    );
+    FIT_TEST_CHECK(f("plus", 3, 2) == 5);
+    FIT_TEST_CHECK(f("minus", 3, 2) == 1);
+    FIT_TEST_CHECK(f("times", 3, 2) == 0);
+}
+
+// The result is the common type of every case and the fallback
+FIT_TEST_CASE()
+{
+    auto f = fit::string_switch(
+        fit::string_case("one", key_index<1>()),
+        [](const std::string&) { return 0.5; }
+    );
+    STATIC_ASSERT_SAME(decltype(f(std::string())), double);
+    FIT_TEST_CHECK(f(std::string("one")) == 1.0);
+    FIT_TEST_CHECK(f(std::string("two")) == 0.5);
+}
+
+// Many keys, which are all found, and strings that are not keys go to the
+// fallback
+FIT_TEST_CASE()
+{
+    static constexpr auto f = fit::string_switch(
+        fit::string_case("get", key_index<0>()),
+        fit::string_case("set", key_index<1>()),
+        fit::string_case("add", key_index<2>()),
+        fit::string_case("sub", key_index<3>()),
+        fit::string_case("mul", key_index<4>()),
+        fit::string_case("div", key_index<5>()),
+        fit::string_case("mod", key_index<6>()),
+        fit::string_case("and", key_index<7>()),
+        fit::string_case("or", key_index<8>()),
+        fit::string_case("xor", key_index<9>()),
+        fit::string_case("not", key_index<10>()),
+        fit::string_case("shl", key_index<11>()),
+        fit::string_case("shr", key_index<12>()),
+        fit::string_case("push", key_index<13>()),
+        fit::string_case("pop", key_index<14>()),
+        fit::string_case("peek", key_index<15>()),
+        fit::string_case("dup", key_index<16>()),
+        fit::string_case("swap", key_index<17>()),
+        fit::string_case("drop", key_index<18>()),
+        fit::string_case("over", key_index<19>()),
+        fit::string_case("rot", key_index<20>()),
+        fit::string_case("load", key_index<21>()),
+        fit::string_case("store", key_index<22>()),
+        fit::string_case("open", key_index<23>()),
+        fit::string_case("close", key_index<24>()),
+        fit::string_case("read", key_index<25>()),
+        fit::string_case("write", key_index<26>()),
+        fit::string_case("seek", key_index<27>()),
+        fit::string_case("tell", key_index<28>()),
+        fit::string_case("flush", key_index<29>()),
+        fit::string_case("sync", key_index<30>()),
+        fit::string_case("stat", key_index<31>()),
+        fit::string_case("chmod", key_index<32>()),
+        fit::string_case("chown", key_index<33>()),
+        fit::string_case("link", key_index<34>()),
+        fit::string_case("unlink", key_index<35>()),
+        fit::string_case("rename", key_index<36>()),
+        fit::string_case("mkdir", key_index<37>()),
+        fit::string_case("rmdir", key_index<38>()),
+        fit::string_case("list", key_index<39>()),
+        fit::string_case("find", key_index<40>()),
+        fit::string_case("sort", key_index<41>()),
+        fit::string_case("uniq", key_index<42>()),
+        fit::string_case("head", key_index<43>()),
+        fit::string_case("tail", key_index<44>()),
+        fit::string_case("grep", key_index<45>()),
+        fit::string_case("sed", key_index<46>()),
+        fit::string_case("awk", key_index<47>()),
+        fit::string_case("cut", key_index<48>()),
+        fit::string_case("paste", key_index<49>()),
+        fit::string_case("join", key_index<50>()),
+        fit::string_case("split", key_index<51>()),
+        fit::string_case("merge", key_index<52>()),
+        fit::string_case("diff", key_index<53>()),
+        fit::string_case("patch", key_index<54>()),
+        fit::string_case("send", key_index<55>()),
+        fit::string_case("recv", key_index<56>()),
+        fit::string_case("bind", key_index<57>()),
+        fit::string_case("listen", key_index<58>()),
+        fit::string_case("accept", key_index<59>()),
+        fit::string_case("connect", key_index<60>()),
+        fit::string_case("shutdown", key_index<61>()),
+        fit::string_case("poll", key_index<62>()),
+        unknown()
+    );
+    const char* words[] = { "get", "set", "add", "sub", "mul", "div", "mod", "and", "or", "xor", "not", "shl", "shr", "push", "pop", "peek", "dup", "swap", "drop", "over", "rot", "load", "store", "open", "close", "read", "write", "seek", "tell", "flush", "sync", "stat", "chmod", "chown", "link", "unlink", "rename", "mkdir", "rmdir", "list", "find", "sort", "uniq", "head", "tail", "grep", "sed", "awk", "cut", "paste", "join", "split", "merge", "diff", "patch", "send", "recv", "bind", "listen", "accept", "connect", "shutdown", "poll" };
+    int n = 0;
+    for(const char* w:words)
+    {
+        FIT_TEST_CHECK(f(w) == n);
+        FIT_TEST_CHECK(f(std::string(w)) == n);
+        FIT_TEST_CHECK(f(std::string(w) + "_") == -1);
+        FIT_TEST_CHECK(f("_" + std::string(w)) == -1);
+        n++;
+    }
+    FIT_TEST_CHECK(n == 63);
+    FIT_TEST_CHECK(f("") == -1);
+}
+
+// Equal keys are rejected; in a constexpr adaptor they don't compile
+FIT_TEST_CASE()
+{
+    bool thrown = false;
+    try
+    {
+        fit::string_switch(
+            fit::string_case("add", binary_op{'+'}),
+            fit::string_case("sub", binary_op{'-'}),
+            fit::string_case("add", binary_op{'-'}),
+            zero()
+        );
+    }
+    catch(const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+}
+
+#endif
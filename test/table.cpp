@@ -0,0 +1,88 @@
+#include <fit/table.h>
+#include <fit/fix.h>
+#include "test.h"
+
+struct square
+{
+    constexpr std::size_t operator()(std::size_t x) const
+    {
+        return x * x;
+    }
+};
+
+struct popcount
+{
+    constexpr int operator()(std::size_t x) const
+    {
+        return x == 0 ? 0 : int(x & 1) + (*this)(x >> 1);
+    }
+};
+
+struct crc_bits
+{
+    template<class Self>
+    FIT_FIX_CONSTEXPR unsigned operator()(Self self, unsigned c, int k) const
+    {
+        return k == 0 ? c : self((c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1), k - 1);
+    }
+};
+
+struct crc_entry
+{
+    FIT_FIX_CONSTEXPR unsigned operator()(std::size_t x) const
+    {
+        return fit::fix(crc_bits())(unsigned(x), 8);
+    }
+};
+
+struct factorial_t
+{
+    template<class Self, class T>
+    FIT_FIX_CONSTEXPR T operator()(Self self, T x) const
+    {
+        return x == 0 ? 1 : x * self(x - 1);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_AUTO squares = fit::table<5>(square());
+    STATIC_ASSERT_SAME(std::decay<decltype(squares)>::type, std::array<std::size_t, 5>);
+    FIT_STATIC_TEST_CHECK(squares[0] == 0);
+    FIT_STATIC_TEST_CHECK(squares[4] == 16);
+    FIT_TEST_CHECK(squares[3] == 9);
+
+    FIT_STATIC_AUTO empty = fit::table<0>(square());
+    FIT_STATIC_TEST_CHECK(empty.size() == 0);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_AUTO bits = fit::table<256>(popcount());
+    FIT_STATIC_TEST_CHECK(bits[0] == 0);
+    FIT_STATIC_TEST_CHECK(bits[255] == 8);
+    for(std::size_t i = 0; i < 256; i++) FIT_TEST_CHECK(bits[i] == popcount()(i));
+}
+
+#if FIT_FIX_HAS_CONSTEXPR
+FIT_TEST_CASE()
+{
+    FIT_STATIC_AUTO crc = fit::table<256>(crc_entry());
+    FIT_STATIC_TEST_CHECK(crc[0] == 0);
+    FIT_STATIC_TEST_CHECK(crc[1] == 0x77073096u);
+    FIT_STATIC_TEST_CHECK(crc[255] == 0x2D02EF8Du);
+
+    FIT_STATIC_AUTO factorials = fit::table<13>(fit::fix(factorial_t()));
+    FIT_STATIC_TEST_CHECK(factorials[0] == 1);
+    FIT_STATIC_TEST_CHECK(factorials[12] == 479001600);
+}
+#endif
+
+FIT_TEST_CASE()
+{
+    auto crc = fit::table<256>(crc_entry());
+    FIT_TEST_CHECK(crc[1] == 0x77073096u);
+    FIT_TEST_CHECK(crc[128] == 0xEDB88320u);
+    auto factorials = fit::table<6>(fit::fix(factorial_t()));
+    FIT_TEST_CHECK(factorials[5] == 120);
+}
@@ -171,6 +171,35 @@ struct move_class
     }
 };
 
+// Counts how many times it has been copied or moved
+struct copy_counter
+{
+    int* copies;
+    int* moves;
+    copy_counter(int* c, int* m) : copies(c), moves(m)
+    {}
+
+    copy_counter(const copy_counter& rhs) : copies(rhs.copies), moves(rhs.moves)
+    {
+        ++*copies;
+    }
+
+    copy_counter(copy_counter&& rhs) : copies(rhs.copies), moves(rhs.moves)
+    {
+        ++*moves;
+    }
+};
+
+// Takes its arguments by value, so they are either copied or moved
+struct by_value_class
+{
+    template<class T, class U>
+    int operator()(T, U) const
+    {
+        return 2;
+    }
+};
+
 int main()
 {
 	for(const auto& tc: fit::test::test_cases) tc();
@@ -191,3 +191,69 @@ FIT_TEST_CASE()
     STATIC_ASSERT_SAME(deduce_types<int, int, int>, decltype(deduce(fit::pack(1), fit::pack(2), fit::pack(3))));
     // STATIC_ASSERT_SAME(deduce_types<int&&, int&&>, decltype(deduce(fit::pack_forward(1, 2))));
 }
+
+FIT_TEST_CASE()
+{
+    static_assert(fit::is_unpackable<std::pair<int, int>>::value, "Pair not unpackable");
+    static_assert(fit::is_unpackable<std::array<int, 2>>::value, "Array not unpackable");
+    static_assert(fit::is_unpackable<const std::array<int, 2>&>::value, "Array not unpackable");
+
+    FIT_TEST_CHECK(3 == fit::unpack(binary_class())(std::make_pair(1, 2)));
+    FIT_TEST_CHECK(3 == fit::unpack(binary_class())(std::array<int, 2>{{1, 2}}));
+    FIT_TEST_CHECK(3 == fit::unpack(binary_class())(std::make_pair(1, 2), std::array<int, 0>()));
+    FIT_TEST_CHECK(3 == fit::unpack(binary_class())(std::array<int, 1>{{1}}, std::make_tuple(2)));
+
+    FIT_STATIC_TEST_CHECK(3 == fit::unpack(binary_class())(std::make_pair(1, 2)));
+    FIT_STATIC_TEST_CHECK(3 == fit::unpack(binary_class())(std::array<int, 2>{{1, 2}}));
+
+    const auto p = std::make_pair(1, 2);
+    std::array<int, 2> a = {{1, 2}};
+    FIT_TEST_CHECK(3 == fit::unpack(binary_class())(p));
+    FIT_TEST_CHECK(3 == fit::unpack(binary_class())(a));
+    STATIC_ASSERT_SAME(deduce_types<const int&, const int&>, decltype(deduce(p)));
+    STATIC_ASSERT_SAME(deduce_types<int&, int&>, decltype(deduce(a)));
+    STATIC_ASSERT_SAME(deduce_types<int, int>, decltype(deduce(std::array<int, 2>())));
+}
+
+FIT_TEST_CASE()
+{
+    int i = 1;
+    auto t = std::tuple<int&, int>(i, 2);
+    STATIC_ASSERT_SAME(deduce_types<int&, int&>, decltype(deduce(t)));
+    STATIC_ASSERT_SAME(deduce_types<int&, int>, decltype(deduce(std::move(t))));
+    STATIC_ASSERT_SAME(deduce_types<int&, const int&>, decltype(deduce(static_cast<const std::tuple<int&, int>&>(t))));
+}
+
+struct by_value_unpack
+{
+    template<class... Ts>
+    int operator()(Ts...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto t = std::make_tuple(copy_counter(&copies, &moves), copy_counter(&copies, &moves));
+    auto p = std::make_pair(copy_counter(&copies, &moves), copy_counter(&copies, &moves));
+    std::array<copy_counter, 2> a = {{ copy_counter(&copies, &moves), copy_counter(&copies, &moves) }};
+    copies = 0;
+    moves = 0;
+    // Lvalue sequences are never moved from
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(t) == 2);
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(p) == 2);
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(a) == 2);
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(t, p, a) == 6);
+    FIT_TEST_CHECK(copies == 12);
+    FIT_TEST_CHECK(moves == 0);
+    copies = 0;
+    // Rvalue sequences have each element moved exactly once
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(std::move(t)) == 2);
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(std::move(p)) == 2);
+    FIT_TEST_CHECK(fit::unpack(by_value_unpack())(std::move(a)) == 2);
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(moves == 6);
+}
@@ -0,0 +1,128 @@
+#include <fit/unpack_n.h>
+#include <fit/conditional.h>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "test.h"
+
+struct sum_all
+{
+    int operator()() const
+    {
+        return 0;
+    }
+
+    template<class T, class... Ts>
+    int operator()(T x, Ts... xs) const
+    {
+        return x + sum_all()(xs...);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v = {1, 2, 3};
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(v) == 6);
+    FIT_TEST_CHECK(fit::unpack_n<3>(sum_all())(v) == 6);
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(std::vector<int>()) == 0);
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(std::vector<int>{5}) == 5);
+    FIT_TEST_CHECK(fit::unpack_n<0>(sum_all())(std::vector<int>()) == 0);
+
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(v.data(), 2) == 3);
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(v.data(), 0) == 0);
+
+    const std::array<int, 4> a = {{1, 2, 3, 4}};
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(a) == 10);
+
+    int raw[] = {1, 2, 3, 4, 5};
+    FIT_TEST_CHECK(fit::unpack_n<8>(sum_all())(raw, 5) == 15);
+}
+
+struct size_of_args
+{
+    template<class... Ts>
+    std::size_t operator()(Ts&&...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    for(std::size_t i = 0; i <= 16; i++)
+    {
+        std::vector<int> v(i);
+        FIT_TEST_CHECK(fit::unpack_n<16>(size_of_args())(v) == i);
+    }
+}
+
+struct binary_only
+{
+    int operator()(int x, int y) const
+    {
+        return x * y;
+    }
+};
+
+struct fallback
+{
+    template<class... Ts>
+    int operator()(Ts&&...) const
+    {
+        return -1;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto f = fit::unpack_n<4>(fit::conditional(binary_only(), fallback()));
+    FIT_TEST_CHECK(f(std::vector<int>{3, 4}) == 12);
+    FIT_TEST_CHECK(f(std::vector<int>{3}) == -1);
+    FIT_TEST_CHECK(f(std::vector<int>{3, 4, 5}) == -1);
+}
+
+struct count_moved
+{
+    template<class... Ts>
+    std::size_t operator()(Ts... xs) const
+    {
+        std::size_t n = 0;
+        for(const std::string& x: {std::string(), xs...}) n += x.empty() ? 0 : 1;
+        return n;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::vector<std::string> v = {"a", "b", "c"};
+    FIT_TEST_CHECK(fit::unpack_n<4>(count_moved())(v) == 3);
+    // Lvalue ranges are not moved from
+    FIT_TEST_CHECK(v[0] == "a" && v[1] == "b" && v[2] == "c");
+    FIT_TEST_CHECK(fit::unpack_n<4>(count_moved())(std::move(v)) == 3);
+    FIT_TEST_CHECK(v.size() == 3 && v[0].empty() && v[1].empty() && v[2].empty());
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v = {1, 2};
+    STATIC_ASSERT_SAME(decltype(fit::unpack_n<2>(sum_all())(v)), int);
+    STATIC_ASSERT_SAME(decltype(fit::unpack_n<2>(size_of_args())(v)), std::size_t);
+}
+
+// A range larger than the maximum size throws
+FIT_TEST_CASE()
+{
+    std::vector<int> v(5);
+    bool thrown = false;
+    try
+    {
+        fit::unpack_n<4>(sum_all())(v);
+    }
+    catch(const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+    FIT_TEST_CHECK(fit::unpack_n<4>(sum_all())(v.data(), 4) == 0);
+}
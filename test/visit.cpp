@@ -0,0 +1,143 @@
+#include <fit/visit.h>
+#include "test.h"
+
+#if FIT_HAS_STD_VARIANT
+#include <fit/conditional.h>
+#include <fit/match.h>
+#include <memory>
+#include <string>
+
+struct circle { int r; };
+struct square { int side; };
+struct rect { int w; int h; };
+
+typedef std::variant<circle, square, rect> shape;
+
+struct area_t
+{
+    constexpr int operator()(circle c) const { return 3 * c.r * c.r; }
+    constexpr int operator()(square s) const { return s.side * s.side; }
+    constexpr int operator()(rect r) const { return r.w * r.h; }
+};
+
+FIT_TEST_CASE()
+{
+    auto area = fit::visit(fit::match(
+        [](circle c) { return 3 * c.r * c.r; },
+        [](square s) { return s.side * s.side; },
+        [](rect r) { return r.w * r.h; }
+    ));
+    FIT_TEST_CHECK(area(shape(circle{2})) == 12);
+    FIT_TEST_CHECK(area(shape(square{3})) == 9);
+    shape s = rect{2, 5};
+    FIT_TEST_CHECK(area(s) == 10);
+    const shape cs = square{4};
+    FIT_TEST_CHECK(area(cs) == 16);
+}
+
+FIT_TEST_CASE()
+{
+    constexpr shape s = rect{3, 4};
+    FIT_STATIC_TEST_CHECK(fit::visit(area_t())(s) == 12);
+    FIT_STATIC_TEST_CHECK(fit::visit(area_t())(shape(circle{1})) == 3);
+}
+
+// The first function that can be called is used, as with conditional
+FIT_TEST_CASE()
+{
+    auto kind = fit::visit(fit::conditional(
+        [](square) { return 1; },
+        [](auto) { return 2; },
+        [](circle) { return 3; }
+    ));
+    FIT_TEST_CHECK(kind(shape(square{1})) == 1);
+    FIT_TEST_CHECK(kind(shape(circle{1})) == 2);
+    FIT_TEST_CHECK(kind(shape(rect{1, 1})) == 2);
+}
+
+// Every combination of alternatives of several variants
+FIT_TEST_CASE()
+{
+    typedef std::variant<int, std::string> value;
+    auto describe = fit::visit(fit::match(
+        [](int x, int y) { return std::to_string(x + y); },
+        [](int x, const std::string& s) { return std::to_string(x) + s; },
+        [](const std::string& s, int y) { return s + std::to_string(y); },
+        [](const std::string& s, const std::string& t) { return s + t; }
+    ));
+    FIT_TEST_CHECK(describe(value(1), value(2)) == "3");
+    FIT_TEST_CHECK(describe(value(1), value("a")) == "1a");
+    FIT_TEST_CHECK(describe(value("a"), value(2)) == "a2");
+    FIT_TEST_CHECK(describe(value("a"), value("b")) == "ab");
+
+    auto index3 = fit::visit([](auto x, auto y, auto z) { return x * 100 + y * 10 + z; });
+    std::variant<int, long> a = 1L;
+    std::variant<short, int, long> b = 2;
+    std::variant<int> c = 3;
+    STATIC_ASSERT_SAME(decltype(index3(a, b, c)), long);
+    FIT_TEST_CHECK(index3(a, b, c) == 123);
+    b = short(4);
+    FIT_TEST_CHECK(index3(a, b, c) == 143);
+    FIT_TEST_CHECK(fit::visit([] { return 7; })() == 7);
+}
+
+// The results are converted to their common type
+FIT_TEST_CASE()
+{
+    auto f = fit::visit(fit::match(
+        [](int) { return 1; },
+        [](double) { return 2.5; }
+    ));
+    STATIC_ASSERT_SAME(decltype(f(std::variant<int, double>())), double);
+    FIT_TEST_CHECK(f(std::variant<int, double>(1)) == 1.0);
+    FIT_TEST_CHECK(f(std::variant<int, double>(1.0)) == 2.5);
+}
+
+// The alternatives keep their value category
+FIT_TEST_CASE()
+{
+    typedef std::variant<std::unique_ptr<int>, int> owner;
+    auto take = fit::visit(fit::match(
+        [](std::unique_ptr<int>&& p) { return *p; },
+        [](std::unique_ptr<int>&) { return -1; },
+        [](int x) { return x; }
+    ));
+    owner o = std::unique_ptr<int>(new int(5));
+    FIT_TEST_CHECK(take(o) == -1);
+    FIT_TEST_CHECK(take(fit::move(o)) == 5);
+    FIT_TEST_CHECK(take(owner(3)) == 3);
+}
+
+struct throws_on_copy
+{
+    throws_on_copy()
+    {}
+    throws_on_copy(const throws_on_copy&)
+    {
+        throw 1;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::variant<int, throws_on_copy> v = 1;
+    try
+    {
+        v.emplace<throws_on_copy>(throws_on_copy());
+    }
+    catch(int)
+    {}
+    FIT_TEST_CHECK(v.valueless_by_exception());
+    bool thrown = false;
+    try
+    {
+        fit::visit([](auto&&) { return 0; })(v);
+    }
+    catch(const std::bad_variant_access&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+}
+
+#endif